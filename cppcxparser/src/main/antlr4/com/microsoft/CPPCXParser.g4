@@ -154,55 +154,40 @@ castExpression:
 	unaryExpression
 	| LeftParen theTypeId RightParen castExpression;
 
-pointerMemberExpression:
-	castExpression ((DotStar | ArrowStar) castExpression)*;
-
-multiplicativeExpression:
-	pointerMemberExpression (
-		(Star | Div | Mod) pointerMemberExpression
-	)*;
-
-additiveExpression:
-	multiplicativeExpression (
-		(Plus | Minus) multiplicativeExpression
-	)*;
-
-shiftExpression:
-	additiveExpression (shiftOperator additiveExpression)*;
+/*
+ * All binary operators in one left-recursive rule, highest precedence first, so
+ * that an operand does not nest a context for every precedence level. Each
+ * alternative is labeled with the name of the rule it replaces.
+ */
+binaryExpression:
+	castExpression													# castOperand
+	| binaryExpression (DotStar | ArrowStar) binaryExpression		# pointerMemberExpression
+	| binaryExpression (Star | Div | Mod) binaryExpression			# multiplicativeExpression
+	| binaryExpression (Plus | Minus) binaryExpression				# additiveExpression
+	| binaryExpression shiftOperator binaryExpression				# shiftExpression
+	| binaryExpression (
+		Less
+		| Greater
+		| LessEqual
+		| GreaterEqual
+	) binaryExpression												# relationalExpression
+	| binaryExpression (Equal | NotEqual) binaryExpression			# equalityExpression
+	| binaryExpression And binaryExpression							# andExpression
+	| binaryExpression Caret binaryExpression						# exclusiveOrExpression
+	| binaryExpression Or binaryExpression							# inclusiveOrExpression
+	| binaryExpression AndAnd binaryExpression						# logicalAndExpression
+	| binaryExpression OrOr binaryExpression						# logicalOrExpression;
 
 shiftOperator: Greater Greater | Less Less;
 
-relationalExpression:
-	shiftExpression (
-		(Less | Greater | LessEqual | GreaterEqual) shiftExpression
-	)*;
-
-equalityExpression:
-	relationalExpression (
-		(Equal | NotEqual) relationalExpression
-	)*;
-
-andExpression: equalityExpression (And equalityExpression)*;
-
-exclusiveOrExpression: andExpression (Caret andExpression)*;
-
-inclusiveOrExpression:
-	exclusiveOrExpression (Or exclusiveOrExpression)*;
-
-logicalAndExpression:
-	inclusiveOrExpression (AndAnd inclusiveOrExpression)*;
-
-logicalOrExpression:
-	logicalAndExpression (OrOr logicalAndExpression)*;
-
 conditionalExpression:
-	logicalOrExpression (
+	binaryExpression (
 		Question expression Colon assignmentExpression
 	)?;
 
 assignmentExpression:
 	conditionalExpression
-	| logicalOrExpression assignmentOperator initializerClause
+	| binaryExpression assignmentOperator initializerClause
 	| throwExpression;
 
 assignmentOperator:
@@ -0,0 +1,249 @@
+package com.microsoft.calculator;
+
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.IdentityHashMap;
+import java.util.LinkedHashMap;
+import java.util.LinkedHashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+/**
+ * Inverted indexes over the {@link ApiModel}s of many files, so that a query
+ * costs in proportion to its result.
+ *
+ * Classes are indexed by base type, attribute, enclosing scope and
+ * qualified name, properties by type and enums by scope and qualified name.
+ * Types, bases and attributes match as written without whitespace, like
+ * {@code Platform::String^}, or by their unqualified name, like
+ * {@code INotifyPropertyChanged} for
+ * {@code Windows::UI::Xaml::Data::INotifyPropertyChanged}. Whitespace in a
+ * query is ignored. Results are in the order the files were put and, within
+ * a file, in source order.
+ *
+ * {@link #put} replaces the model of a file, so the index can follow files
+ * as they change. Safe to share between threads.
+ */
+public class ApiIndex {
+
+    private final Map<Path, ApiModel> models = new LinkedHashMap<>();
+    private final Map<Object, Path> files = new IdentityHashMap<>();
+    private final Map<String, Set<ApiModel.ClassInfo>> classesByBase = new HashMap<>();
+    private final Map<String, Set<ApiModel.ClassInfo>> classesByAttribute = new HashMap<>();
+    private final Map<String, Set<ApiModel.ClassInfo>> classesByScope = new HashMap<>();
+    private final Map<String, Set<ApiModel.ClassInfo>> classesByName = new HashMap<>();
+    private final Map<String, Set<Property>> propertiesByType = new HashMap<>();
+    private final Map<String, Set<ApiModel.EnumInfo>> enumsByScope = new HashMap<>();
+    private final Map<String, Set<ApiModel.EnumInfo>> enumsByName = new HashMap<>();
+
+    /**
+     * Indexes the model of the file in place of the one put before.
+     */
+    public synchronized void put(Path file, ApiModel model) {
+        remove(file);
+        models.put(file, model);
+        for (ApiModel.ClassInfo cls : model.getClasses()) {
+            files.put(cls, file);
+            for (String base : cls.getBases())
+                addType(classesByBase, base, cls);
+            for (String attribute : cls.getAttributes())
+                addType(classesByAttribute, attribute, cls);
+            add(classesByScope, cls.getScope(), cls);
+            add(classesByName, cls.getQualifiedName(), cls);
+            for (ApiModel.PropertyInfo property : cls.getProperties())
+                addType(propertiesByType, property.getType(), new Property(cls, property));
+        }
+        for (ApiModel.EnumInfo e : model.getEnums()) {
+            files.put(e, file);
+            add(enumsByScope, e.getScope(), e);
+            add(enumsByName, e.getQualifiedName(), e);
+        }
+    }
+
+    /**
+     * Drops the model of the file.
+     *
+     * @return whether the file was indexed
+     */
+    public synchronized boolean remove(Path file) {
+        ApiModel model = models.remove(file);
+        if (model == null)
+            return false;
+        for (ApiModel.ClassInfo cls : model.getClasses()) {
+            files.remove(cls);
+            for (String base : cls.getBases())
+                removeType(classesByBase, base, cls);
+            for (String attribute : cls.getAttributes())
+                removeType(classesByAttribute, attribute, cls);
+            remove(classesByScope, cls.getScope(), cls);
+            remove(classesByName, cls.getQualifiedName(), cls);
+            for (ApiModel.PropertyInfo property : cls.getProperties())
+                removeType(propertiesByType, property.getType(), new Property(cls, property));
+        }
+        for (ApiModel.EnumInfo e : model.getEnums()) {
+            files.remove(e);
+            remove(enumsByScope, e.getScope(), e);
+            remove(enumsByName, e.getQualifiedName(), e);
+        }
+        return true;
+    }
+
+    public synchronized List<Path> getFiles() {
+        return new ArrayList<>(models.keySet());
+    }
+
+    public synchronized ApiModel getModel(Path file) {
+        return models.get(file);
+    }
+
+    /**
+     * The file a class or enum of the index was declared in, or null.
+     */
+    public synchronized Path getFile(Object classOrEnum) {
+        return files.get(classOrEnum);
+    }
+
+    /**
+     * Classes that derive from or implement the type.
+     */
+    public synchronized List<ApiModel.ClassInfo> getClassesWithBase(String type) {
+        return get(classesByBase, key(type));
+    }
+
+    /**
+     * Classes with the C++/CX attribute, like {@code Bindable}.
+     */
+    public synchronized List<ApiModel.ClassInfo> getClassesWithAttribute(String attribute) {
+        return get(classesByAttribute, key(attribute));
+    }
+
+    /**
+     * Classes declared directly in the namespace or class, "" for the global
+     * namespace.
+     */
+    public synchronized List<ApiModel.ClassInfo> getClassesIn(String scope) {
+        return get(classesByScope, key(scope));
+    }
+
+    /**
+     * The declarations of the class; more than one if several files declare
+     * it.
+     */
+    public synchronized List<ApiModel.ClassInfo> getClasses(String qualifiedName) {
+        return get(classesByName, key(qualifiedName));
+    }
+
+    /**
+     * Properties of the type, with the classes declaring them.
+     */
+    public synchronized List<Property> getPropertiesOfType(String type) {
+        return get(propertiesByType, key(type));
+    }
+
+    public synchronized List<ApiModel.EnumInfo> getEnumsIn(String scope) {
+        return get(enumsByScope, key(scope));
+    }
+
+    public synchronized List<ApiModel.EnumInfo> getEnums(String qualifiedName) {
+        return get(enumsByName, key(qualifiedName));
+    }
+
+    private static String key(String query) {
+        return query.replaceAll("\\s+", "");
+    }
+
+    /**
+     * The name after the last {@code ::} outside template arguments, or null
+     * if the type is not qualified.
+     */
+    static String unqualified(String type) {
+        int depth = 0;
+        for (int i = type.length() - 1; i > 0; i--) {
+            char c = type.charAt(i);
+            if (c == '>')
+                depth++;
+            else if (c == '<')
+                depth--;
+            else if (c == ':' && depth == 0 && type.charAt(i - 1) == ':')
+                return i + 1 < type.length() ? type.substring(i + 1) : null;
+        }
+        return null;
+    }
+
+    private static <T> void addType(Map<String, Set<T>> index, String type, T value) {
+        add(index, type, value);
+        String name = unqualified(type);
+        if (name != null)
+            add(index, name, value);
+    }
+
+    private static <T> void removeType(Map<String, Set<T>> index, String type, T value) {
+        remove(index, type, value);
+        String name = unqualified(type);
+        if (name != null)
+            remove(index, name, value);
+    }
+
+    private static <T> void add(Map<String, Set<T>> index, String key, T value) {
+        Set<T> values = index.get(key);
+        if (values == null) {
+            values = new LinkedHashSet<>();
+            index.put(key, values);
+        }
+        values.add(value);
+    }
+
+    private static <T> void remove(Map<String, Set<T>> index, String key, T value) {
+        Set<T> values = index.get(key);
+        if (values == null)
+            return;
+        values.remove(value);
+        if (values.isEmpty())
+            index.remove(key);
+    }
+
+    private static <T> List<T> get(Map<String, Set<T>> index, String key) {
+        Collection<T> values = index.get(key);
+        return values == null ? Collections.<T>emptyList() : new ArrayList<>(values);
+    }
+
+    /**
+     * A property and the class that declares it.
+     */
+    public static class Property {
+        private final ApiModel.ClassInfo owner;
+        private final ApiModel.PropertyInfo property;
+
+        Property(ApiModel.ClassInfo owner, ApiModel.PropertyInfo property) {
+            this.owner = owner;
+            this.property = property;
+        }
+
+        public ApiModel.ClassInfo getOwner() {
+            return owner;
+        }
+
+        public ApiModel.PropertyInfo getProperty() {
+            return property;
+        }
+
+        @Override
+        public boolean equals(Object o) {
+            return o instanceof Property && ((Property) o).owner == owner && ((Property) o).property == property;
+        }
+
+        @Override
+        public int hashCode() {
+            return System.identityHashCode(owner) * 31 + System.identityHashCode(property);
+        }
+
+        @Override
+        public String toString() {
+            return owner.getQualifiedName() + "::" + property.getName() + " (" + property.getType() + ")";
+        }
+    }
+}
@@ -0,0 +1,272 @@
+package com.microsoft.calculator;
+
+import java.io.Serializable;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+/**
+ * The WinRT-facing API surface of one or more files: classes with their
+ * attributes, bases and properties, and enums.
+ *
+ * Names and types are kept as written in the source with whitespace removed,
+ * e.g. {@code Platform::String^}. Scopes are the enclosing namespaces and
+ * classes joined with {@code ::}.
+ */
+public class ApiModel implements Serializable {
+    private static final long serialVersionUID = 1L;
+
+    private final List<ClassInfo> classes = new ArrayList<>();
+    private final List<EnumInfo> enums = new ArrayList<>();
+
+    public List<ClassInfo> getClasses() {
+        return Collections.unmodifiableList(classes);
+    }
+
+    public List<EnumInfo> getEnums() {
+        return Collections.unmodifiableList(enums);
+    }
+
+    /**
+     * Classes declared as {@code ref class} or {@code ref struct}.
+     */
+    public List<ClassInfo> getRefClasses() {
+        List<ClassInfo> refClasses = new ArrayList<>();
+        for (ClassInfo cls : classes) {
+            if (cls.isRef())
+                refClasses.add(cls);
+        }
+        return refClasses;
+    }
+
+    void addClass(ClassInfo cls) {
+        classes.add(cls);
+    }
+
+    void addEnum(EnumInfo e) {
+        enums.add(e);
+    }
+
+    /**
+     * Appends everything in the other model to this one.
+     */
+    public void merge(ApiModel other) {
+        classes.addAll(other.classes);
+        enums.addAll(other.enums);
+    }
+
+    public boolean isEmpty() {
+        return classes.isEmpty() && enums.isEmpty();
+    }
+
+    static String qualify(String scope, String name) {
+        return scope.isEmpty() ? name : scope + "::" + name;
+    }
+
+    /**
+     * A class, struct or union.
+     */
+    public static class ClassInfo implements Serializable {
+        private static final long serialVersionUID = 1L;
+
+        private final String scope;
+        private final String name;
+        private final String key;
+        private final boolean ref;
+        private final boolean sealed;
+        private final String access;
+        private final int line;
+        private final List<String> attributes = new ArrayList<>();
+        private final List<String> bases = new ArrayList<>();
+        private final List<PropertyInfo> properties = new ArrayList<>();
+
+        ClassInfo(String scope, String name, String key, boolean ref, boolean sealed, String access, int line) {
+            this.scope = scope;
+            this.name = name;
+            this.key = key;
+            this.ref = ref;
+            this.sealed = sealed;
+            this.access = access;
+            this.line = line;
+        }
+
+        public String getScope() {
+            return scope;
+        }
+
+        /**
+         * The class name, empty for anonymous classes.
+         */
+        public String getName() {
+            return name;
+        }
+
+        public String getQualifiedName() {
+            return qualify(scope, name);
+        }
+
+        /**
+         * {@code class}, {@code struct}, {@code ref class}, {@code ref struct}
+         * or {@code union}.
+         */
+        public String getKey() {
+            return key;
+        }
+
+        public boolean isRef() {
+            return ref;
+        }
+
+        /**
+         * Whether the class is {@code sealed} or {@code final}.
+         */
+        public boolean isSealed() {
+            return sealed;
+        }
+
+        /**
+         * The C++/CX visibility written before the class, or null.
+         */
+        public String getAccess() {
+            return access;
+        }
+
+        public int getLine() {
+            return line;
+        }
+
+        /**
+         * Type names of the {@code [...]} attributes on the class.
+         */
+        public List<String> getAttributes() {
+            return attributes;
+        }
+
+        /**
+         * Type names of the base classes and interfaces.
+         */
+        public List<String> getBases() {
+            return bases;
+        }
+
+        public List<PropertyInfo> getProperties() {
+            return properties;
+        }
+
+        @Override
+        public String toString() {
+            StringBuilder sb = new StringBuilder();
+            for (String attribute : attributes)
+                sb.append('[').append(attribute).append("] ");
+            if (access != null)
+                sb.append(access).append(' ');
+            sb.append(key).append(' ').append(getQualifiedName());
+            if (sealed)
+                sb.append(" sealed");
+            for (int i = 0; i < bases.size(); i++)
+                sb.append(i == 0 ? " : " : ", ").append(bases.get(i));
+            return sb.toString();
+        }
+    }
+
+    /**
+     * A C++/CX {@code property}.
+     */
+    public static class PropertyInfo implements Serializable {
+        private static final long serialVersionUID = 1L;
+
+        private final String name;
+        private final String type;
+        private final int line;
+
+        PropertyInfo(String name, String type, int line) {
+            this.name = name;
+            this.type = type;
+            this.line = line;
+        }
+
+        public String getName() {
+            return name;
+        }
+
+        public String getType() {
+            return type;
+        }
+
+        public int getLine() {
+            return line;
+        }
+
+        @Override
+        public String toString() {
+            return "property " + type + " " + name;
+        }
+    }
+
+    /**
+     * An enum or enum class.
+     */
+    public static class EnumInfo implements Serializable {
+        private static final long serialVersionUID = 1L;
+
+        private final String scope;
+        private final String name;
+        private final boolean scoped;
+        private final String access;
+        private final String underlyingType;
+        private final int line;
+        private final List<String> enumerators = new ArrayList<>();
+
+        EnumInfo(String scope, String name, boolean scoped, String access, String underlyingType, int line) {
+            this.scope = scope;
+            this.name = name;
+            this.scoped = scoped;
+            this.access = access;
+            this.underlyingType = underlyingType;
+            this.line = line;
+        }
+
+        public String getScope() {
+            return scope;
+        }
+
+        public String getName() {
+            return name;
+        }
+
+        public String getQualifiedName() {
+            return qualify(scope, name);
+        }
+
+        /**
+         * Whether this is an {@code enum class} or {@code enum struct}.
+         */
+        public boolean isScoped() {
+            return scoped;
+        }
+
+        public String getAccess() {
+            return access;
+        }
+
+        /**
+         * The type after {@code :}, or null.
+         */
+        public String getUnderlyingType() {
+            return underlyingType;
+        }
+
+        public int getLine() {
+            return line;
+        }
+
+        public List<String> getEnumerators() {
+            return enumerators;
+        }
+
+        @Override
+        public String toString() {
+            return (access != null ? access + " " : "") + (scoped ? "enum class " : "enum ") + getQualifiedName();
+        }
+    }
+}
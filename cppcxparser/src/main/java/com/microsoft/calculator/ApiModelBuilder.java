@@ -0,0 +1,176 @@
+package com.microsoft.calculator;
+
+import com.microsoft.CPPCXParser.*;
+import com.microsoft.CPPCXParserBaseVisitor;
+
+import org.antlr.v4.runtime.tree.ParseTree;
+import org.antlr.v4.runtime.tree.RuleNode;
+
+/**
+ * Extracts an {@link ApiModel} from a parse tree like a {@link CxListener}
+ * walk, but only visits the nodes that can lead to the API surface.
+ *
+ * A walk visits every node of the tree, most of them in function bodies,
+ * initializers and declarators that the listener ignores. This visitor only
+ * descends through declarations, declaration specifiers, namespace
+ * definitions, class specifiers and their member specifications; it stops at
+ * function bodies, declarators and everything else, so its cost grows with
+ * the declared API rather than with the code. Types declared inside those,
+ * such as local classes, are therefore not extracted. The model itself is
+ * built by the listener's enter and exit methods.
+ */
+public class ApiModelBuilder extends CPPCXParserBaseVisitor<Void> {
+
+    private final CxListener listener;
+
+    public ApiModelBuilder() {
+        this(new CxListener());
+    }
+
+    /**
+     * A builder that adds to the model of the listener.
+     */
+    public ApiModelBuilder(CxListener listener) {
+        this.listener = listener;
+    }
+
+    public static ApiModel build(ParseTree tree) {
+        ApiModelBuilder builder = new ApiModelBuilder();
+        builder.visit(tree);
+        return builder.getModel();
+    }
+
+    public ApiModel getModel() {
+        return listener.getModel();
+    }
+
+    /**
+     * Prunes every rule without an override below.
+     */
+    @Override
+    public Void visitChildren(RuleNode node) {
+        return null;
+    }
+
+    private Void descend(RuleNode node) {
+        return super.visitChildren(node);
+    }
+
+    @Override
+    public Void visitTranslationUnit(TranslationUnitContext ctx) {
+        return descend(ctx);
+    }
+
+    @Override
+    public Void visitDeclarationseq(DeclarationseqContext ctx) {
+        return descend(ctx);
+    }
+
+    @Override
+    public Void visitDeclaration(DeclarationContext ctx) {
+        return descend(ctx);
+    }
+
+    @Override
+    public Void visitBlockDeclaration(BlockDeclarationContext ctx) {
+        return descend(ctx);
+    }
+
+    @Override
+    public Void visitSimpleDeclaration(SimpleDeclarationContext ctx) {
+        return ctx.declSpecifierSeq() == null ? null : visit(ctx.declSpecifierSeq());
+    }
+
+    @Override
+    public Void visitDeclSpecifierSeq(DeclSpecifierSeqContext ctx) {
+        for (DeclSpecifierContext specifier : ctx.declSpecifier())
+            visit(specifier);
+        return null;
+    }
+
+    @Override
+    public Void visitDeclSpecifier(DeclSpecifierContext ctx) {
+        return ctx.typeSpecifier() == null ? null : visit(ctx.typeSpecifier());
+    }
+
+    @Override
+    public Void visitTypeSpecifier(TypeSpecifierContext ctx) {
+        if (ctx.classSpecifier() != null)
+            return visit(ctx.classSpecifier());
+        return ctx.enumSpecifier() == null ? null : visit(ctx.enumSpecifier());
+    }
+
+    @Override
+    public Void visitTemplateDeclaration(TemplateDeclarationContext ctx) {
+        return ctx.declaration() == null ? null : visit(ctx.declaration());
+    }
+
+    @Override
+    public Void visitExplicitInstantiation(ExplicitInstantiationContext ctx) {
+        return ctx.declaration() == null ? null : visit(ctx.declaration());
+    }
+
+    @Override
+    public Void visitExplicitSpecialization(ExplicitSpecializationContext ctx) {
+        return ctx.declaration() == null ? null : visit(ctx.declaration());
+    }
+
+    @Override
+    public Void visitLinkageSpecification(LinkageSpecificationContext ctx) {
+        return descend(ctx);
+    }
+
+    @Override
+    public Void visitNamespaceDefinition(NamespaceDefinitionContext ctx) {
+        listener.enterNamespaceDefinition(ctx);
+        if (ctx.namespaceBody != null)
+            visit(ctx.namespaceBody);
+        listener.exitNamespaceDefinition(ctx);
+        return null;
+    }
+
+    @Override
+    public Void visitFunctionDefinition(FunctionDefinitionContext ctx) {
+        // The return type may define a class; the body is never visited.
+        return ctx.declSpecifierSeq() == null ? null : visit(ctx.declSpecifierSeq());
+    }
+
+    @Override
+    public Void visitClassSpecifier(ClassSpecifierContext ctx) {
+        listener.enterClassSpecifier(ctx);
+        if (ctx.memberSpecification() != null)
+            visit(ctx.memberSpecification());
+        listener.exitClassSpecifier(ctx);
+        return null;
+    }
+
+    @Override
+    public Void visitMemberSpecification(MemberSpecificationContext ctx) {
+        for (MemberdeclarationContext member : ctx.memberdeclaration())
+            visit(member);
+        return null;
+    }
+
+    @Override
+    public Void visitMemberdeclaration(MemberdeclarationContext ctx) {
+        if (ctx.declSpecifierSeq() != null)
+            return visit(ctx.declSpecifierSeq());
+        if (ctx.functionDefinition() != null)
+            return visit(ctx.functionDefinition());
+        if (ctx.propertyDefinition() != null)
+            return visit(ctx.propertyDefinition());
+        return ctx.templateDeclaration() == null ? null : visit(ctx.templateDeclaration());
+    }
+
+    @Override
+    public Void visitPropertyDefinition(PropertyDefinitionContext ctx) {
+        listener.enterPropertyDefinition(ctx);
+        return null;
+    }
+
+    @Override
+    public Void visitEnumSpecifier(EnumSpecifierContext ctx) {
+        listener.enterEnumSpecifier(ctx);
+        return null;
+    }
+}
@@ -2,6 +2,15 @@ package com.microsoft.calculator;
 
 import java.io.IOException;
 import java.io.InputStream;
+import java.io.InputStreamReader;
+import java.io.OutputStreamWriter;
+import java.io.Writer;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.List;
 
 import com.microsoft.CPPCXLexer;
 import com.microsoft.CPPCXParser;
@@ -9,34 +18,382 @@ import com.microsoft.CPPCXParser.TranslationUnitContext;
 
 import org.antlr.v4.runtime.CharStreams;
 import org.antlr.v4.runtime.CommonTokenStream;
-import org.antlr.v4.runtime.Lexer;
+import org.antlr.v4.runtime.TokenSource;
 import org.antlr.v4.runtime.TokenStream;
-import org.antlr.v4.runtime.tree.ParseTree;
-import org.antlr.v4.runtime.tree.ParseTreeWalker;
 
 // property
 // attribute
 
 /**
- * Hello world!
+ * Parses the given files and directories, or the bundled example when none
+ * are given.
  *
+ * Usage: App [-j threads] [--stream] [--skip-bodies] [--warm-up] [--dfa-cache file] [--cache dir]
+ *            [--stats file] [--symbols] [--macros file] [--no-macros] [--includes] [-I dir]
+ *            [--pool-tokens] [--max-errors n] [--diagnostics file] [--timeout ms] [--degrade]
+ *            [--split tokens] [--keyword-lexer] [--treeless] [--query kind:name]...
+ *            [--watch] [path...]
+ *
+ * --warm-up parses the bundled example before the given files so that they
+ * start with a populated DFA, which the native image built with -Pnative
+ * already has. --dfa-cache loads the prediction DFA from the
+ * file if it exists (warming up otherwise) and saves it after the run.
+ * --cache keeps the extracted model of every file in the directory and
+ * reuses it while the file and the grammar are unchanged.
+ * --stats writes lex, parse and walk times, token and node counts and
+ * allocated bytes per file, and the prediction statistics of every parser
+ * decision, as JSON to the file ("-" for standard output).
+ * Macro invocations are expanded before parsing, see
+ * {@link MacroExpandingTokenSource}. The Calculator property macros are
+ * predefined, --macros adds the #define lines of a file and --no-macros
+ * turns expansion off.
+ * --symbols only lists the ref classes, enum classes, properties, delegates
+ * and events found by {@link SymbolScanner}, without parsing.
+ * --includes also parses the headers the given files include, each once,
+ * looked up next to the including file and in the -I directories.
+ * --pool-tokens interns token texts across files and reuses token objects,
+ * see {@link InterningTokenFactory}, and reports the token counts.
+ * --max-errors recovers from syntax errors by skipping the broken
+ * declaration and the rest of a file after n errors, see
+ * {@link DeclarationRecoveryStrategy}, and --diagnostics writes the errors
+ * of all files as JSON to the file ("-" for standard output) instead of
+ * printing them.
+ * --timeout gives up on a file after the milliseconds and reports it as
+ * timed out; with --degrade it is parsed again with function bodies skipped.
+ * --split parses files of at least twice the tokens in chunks of at least
+ * that many tokens on all threads, see {@link ChunkedParser}.
+ * --keyword-lexer lexes keywords as identifiers and looks them up in a
+ * {@link KeywordTable}, which gives the same tokens with a smaller lexer DFA.
+ * --treeless extracts the model while parsing instead of building the
+ * parse tree, see {@link TreelessExtractor}, to bound the heap per thread.
+ * --query prints the classes, properties or enums the {@link ApiIndex}
+ * finds instead of the whole model; kind is base, attribute, property (by
+ * type), namespace or enums (in a namespace), as in
+ * {@code --query base:INotifyPropertyChanged}.
+ * --watch keeps running after the first parse, reparses the files that
+ * change below the paths and updates the index, see {@link ProjectIndexer},
+ * and prints the updates or the answers to the queries after each. It does
+ * not follow the include graph, so it cannot be combined with --includes.
+ * --stream parses files one declaration at a time with bounded memory.
+ * --skip-bodies parses function bodies as empty, which is enough for the API
+ * model and much faster.
  */
 public class App {
     public static void main(String[] args) {
-        try {
-            InputStream is = App.class.getResourceAsStream("/example.cpp");
-            Lexer lexer = new CPPCXLexer(CharStreams.fromStream(is));
-            TokenStream tokenStream = new CommonTokenStream(lexer);
-            CPPCXParser parser = new CPPCXParser(tokenStream);
+        int threads = Runtime.getRuntime().availableProcessors();
+        boolean warmUp = false;
+        boolean streaming = false;
+        boolean skipBodies = false;
+        Path dfaCache = null;
+        Path cache = null;
+        String stats = null;
+        boolean symbols = false;
+        boolean expandMacros = true;
+        List<Path> macroFiles = new ArrayList<>();
+        boolean includes = false;
+        boolean poolTokens = false;
+        int maxErrors = 0;
+        String diagnostics = null;
+        long timeout = 0;
+        boolean degrade = false;
+        int chunkTokens = 0;
+        boolean keywordLexer = false;
+        boolean treeless = false;
+        List<String> queries = new ArrayList<>();
+        boolean watch = false;
+        List<Path> includeDirs = new ArrayList<>();
+        List<Path> roots = new ArrayList<>();
+        for (int i = 0; i < args.length; i++) {
+            if (args[i].equals("-j") && i + 1 < args.length)
+                threads = Integer.parseInt(args[++i]);
+            else if (args[i].equals("--stream"))
+                streaming = true;
+            else if (args[i].equals("--skip-bodies"))
+                skipBodies = true;
+            else if (args[i].equals("--warm-up"))
+                warmUp = true;
+            else if (args[i].equals("--dfa-cache") && i + 1 < args.length)
+                dfaCache = Paths.get(args[++i]);
+            else if (args[i].equals("--cache") && i + 1 < args.length)
+                cache = Paths.get(args[++i]);
+            else if (args[i].equals("--macros") && i + 1 < args.length)
+                macroFiles.add(Paths.get(args[++i]));
+            else if (args[i].equals("--no-macros"))
+                expandMacros = false;
+            else if (args[i].equals("--includes"))
+                includes = true;
+            else if (args[i].equals("-I") && i + 1 < args.length)
+                includeDirs.add(Paths.get(args[++i]));
+            else if (args[i].equals("--max-errors") && i + 1 < args.length)
+                maxErrors = Integer.parseInt(args[++i]);
+            else if (args[i].equals("--diagnostics") && i + 1 < args.length)
+                diagnostics = args[++i];
+            else if (args[i].equals("--timeout") && i + 1 < args.length)
+                timeout = Long.parseLong(args[++i]);
+            else if (args[i].equals("--degrade"))
+                degrade = true;
+            else if (args[i].equals("--split") && i + 1 < args.length)
+                chunkTokens = Integer.parseInt(args[++i]);
+            else if (args[i].equals("--keyword-lexer"))
+                keywordLexer = true;
+            else if (args[i].equals("--query") && i + 1 < args.length)
+                queries.add(args[++i]);
+            else if (args[i].equals("--treeless"))
+                treeless = true;
+            else if (args[i].equals("--watch"))
+                watch = true;
+            else if (args[i].equals("--pool-tokens"))
+                poolTokens = true;
+            else if (args[i].equals("--symbols"))
+                symbols = true;
+            else if (args[i].equals("--stats") && i + 1 < args.length)
+                stats = args[++i];
+            else
+                roots.add(Paths.get(args[i]));
+        }
+        if (watch && includes) {
+            System.err.println("--watch cannot be combined with --includes");
+            System.exit(2);
+        }
 
-            TranslationUnitContext tu = parser.translationUnit();
+        try {
+            if (symbols) {
+                scanSymbols(roots);
+                return;
+            }
+            MacroTable macros = null;
+            if (expandMacros) {
+                macros = MacroTable.calculatorDefaults();
+                for (Path file : macroFiles)
+                    macros.defineAll(file);
+            }
+            if (dfaCache != null)
+                warmUp = !loadDfaCache(dfaCache) || warmUp;
+            // A native image starts with the DFA of the example, see NativeImageWarmUp.
+            if (warmUp && !(inNativeImage() && NativeImageWarmUp.DFA_STATES > 0))
+                DfaCache.warmUp();
 
-            CxListener listener = new CxListener();
-            ParseTreeWalker.DEFAULT.walk(listener, tu);
+            if (roots.isEmpty()) {
+                parseExample(streaming, skipBodies, macros);
+            } else {
+                BatchParser batch = new BatchParser(threads);
+                batch.setStreaming(streaming);
+                batch.setSkipBodies(skipBodies);
+                batch.setPoolTokens(poolTokens);
+                if (maxErrors > 0 || diagnostics != null)
+                    batch.setMaxErrors(maxErrors > 0 ? maxErrors : DeclarationRecoveryStrategy.DEFAULT_MAX_ERRORS);
+                batch.setTimeout(timeout);
+                batch.setDegradeOnTimeout(degrade);
+                batch.setChunkTokens(chunkTokens);
+                batch.setKeywordLexer(keywordLexer);
+                batch.setTreeless(treeless);
+                batch.setMacros(macros);
+                if (cache != null) {
+                    // Skipped bodies are guessed from the tokens, so such models are kept apart from full parses.
+                    String configuration = (macros == null ? "" : macros.fingerprint())
+                            + (skipBodies ? "skip-bodies\n" : "");
+                    batch.setCache(new ParseCache(cache, configuration));
+                }
+                if (stats != null)
+                    batch.setStats(new ParseStats());
+                parseBatch(batch, roots, includes ? new IncludeResolver(includeDirs) : null, watch, queries,
+                        diagnostics, stats);
+            }
 
+            if (dfaCache != null)
+                DfaCache.save(dfaCache);
         } catch (IOException e) {
             e.printStackTrace();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+        }
+    }
+
+    private static boolean inNativeImage() {
+        return "runtime".equals(System.getProperty("org.graalvm.nativeimage.imagecode"));
+    }
+
+    private static boolean loadDfaCache(Path file) {
+        if (!Files.exists(file))
+            return false;
+        try {
+            DfaCache.load(file);
+            return true;
+        } catch (IOException e) {
+            System.err.println(file + ": " + e.getMessage());
+            return false;
+        }
+    }
+
+    private static void parseExample(boolean streaming, boolean skipBodies, MacroTable macros)
+            throws IOException {
+        try (InputStream is = App.class.getResourceAsStream("/example.cpp")) {
+            if (streaming) {
+                CxListener listener = new CxListener();
+                StreamingParser streamingParser = new StreamingParser();
+                streamingParser.setSkipBodies(skipBodies);
+                streamingParser.setMacros(macros);
+                streamingParser.parse(new InputStreamReader(is, StandardCharsets.UTF_8), "example.cpp", listener);
+                print(listener.getModel());
+                return;
+            }
+
+            TokenSource source = new CPPCXLexer(CharStreams.fromStream(is));
+            if (macros != null)
+                source = new MacroExpandingTokenSource(source, macros);
+            if (skipBodies)
+                source = new SkipBodyTokenSource(source);
+            TokenStream tokenStream = new CommonTokenStream(source);
+            CPPCXParser parser = new CPPCXParser(tokenStream);
+
+            TwoStageParser twoStage = new TwoStageParser();
+            TranslationUnitContext tu = twoStage.parse(parser);
+
+            print(ApiModelBuilder.build(tu));
+            System.out.println(twoStage);
+        }
+    }
+
+    /**
+     * Parses the roots with the configured parser and prints the results;
+     * the diagnostics and stats are the JSON files to write, if any.
+     */
+    private static void parseBatch(BatchParser batch, List<Path> roots, IncludeResolver resolver, boolean watch,
+            List<String> queries, String diagnostics, String stats) throws IOException, InterruptedException {
+        List<Path> files = BatchParser.collectSources(roots);
+        ProjectParser.ProjectResult project = null;
+        ProjectIndexer indexer = null;
+        BatchParser.BatchResult result;
+        if (resolver != null) {
+            project = new ProjectParser(batch, resolver).parse(files);
+            result = project.getBatchResult();
+        } else if (watch) {
+            indexer = new ProjectIndexer(batch, roots);
+            result = indexer.start();
+        } else {
+            result = batch.parse(files);
+        }
+
+        List<DiagnosticCollector.Diagnostic> errors = new ArrayList<>();
+        for (BatchParser.FileResult file : result.getFiles()) {
+            if (file.getFailure() != null)
+                System.err.println(file.getFile() + ": " + file.getFailure());
+            errors.addAll(file.getDiagnostics());
+        }
+        if (diagnostics != null) {
+            writeDiagnostics(errors, diagnostics);
+        } else {
+            for (DiagnosticCollector.Diagnostic error : errors)
+                System.err.println(error);
+        }
+        if (queries.isEmpty()) {
+            print(result.getModel());
+        } else {
+            ApiIndex index = indexer != null ? indexer.getIndex() : result.getIndex();
+            for (String query : queries)
+                query(index, query);
+        }
+        if (project != null)
+            System.out.println(project.getGraph().getHeaders().size() + " headers, "
+                    + project.getGraph().getUnresolvedCount() + " unresolved includes");
+        System.out.println(result.getFiles().size() + " files, " + result.getFailureCount() + " failed, "
+                + (batch.getTimeout() > 0
+                        ? result.getTimeoutCount() + " timed out, " + result.getDegradedCount() + " degraded, " : "")
+                + result.getSyntaxErrorCount() + " syntax errors, " + batch.getTwoStageParser()
+                + (batch.getCache() != null ? ", " + batch.getCache() : "")
+                + (batch.getTokenCounts() != null ? ", " + batch.getTokenCounts() : ""));
+        if (stats != null)
+            writeStats(batch.getStats(), stats);
+        if (indexer != null)
+            watch(indexer, queries);
+    }
+
+    private static void watch(final ProjectIndexer indexer, final List<String> queries) throws IOException {
+        indexer.setListener(new ProjectIndexer.Listener() {
+            @Override
+            public void updated(BatchParser.BatchResult result, List<Path> removed) {
+                for (BatchParser.FileResult file : result.getFiles()) {
+                    if (file.getFailure() != null)
+                        System.err.println(file.getFile() + ": " + file.getFailure());
+                }
+                System.out.println(result.getFiles().size() + " files reparsed, " + removed.size() + " removed, "
+                        + indexer.getIndex().getFiles().size() + " indexed");
+                for (String query : queries)
+                    query(indexer.getIndex(), query);
+            }
+        });
+        try {
+            indexer.run();
+        } finally {
+            indexer.close();
+        }
+    }
+
+    private static void writeDiagnostics(List<DiagnosticCollector.Diagnostic> diagnostics, String file)
+            throws IOException {
+        if (file.equals("-")) {
+            DiagnosticCollector.writeJson(diagnostics, new OutputStreamWriter(System.out, StandardCharsets.UTF_8));
+            return;
+        }
+        try (Writer writer = Files.newBufferedWriter(Paths.get(file), StandardCharsets.UTF_8)) {
+            DiagnosticCollector.writeJson(diagnostics, writer);
+        }
+    }
+
+    private static void writeStats(ParseStats stats, String file) throws IOException {
+        if (file.equals("-")) {
+            Writer writer = new OutputStreamWriter(System.out, StandardCharsets.UTF_8);
+            stats.writeJson(writer);
+            return;
+        }
+        try (Writer writer = Files.newBufferedWriter(Paths.get(file), StandardCharsets.UTF_8)) {
+            stats.writeJson(writer);
+        }
+    }
+
+    private static void scanSymbols(List<Path> roots) throws IOException {
+        SymbolScanner scanner = new SymbolScanner();
+        if (roots.isEmpty()) {
+            try (InputStream is = App.class.getResourceAsStream("/example.cpp")) {
+                for (SymbolScanner.Symbol symbol : scanner.scan(CharStreams.fromStream(is)))
+                    System.out.println("example.cpp:" + symbol);
+            }
+            return;
         }
+        for (Path file : BatchParser.collectSources(roots)) {
+            for (SymbolScanner.Symbol symbol : scanner.scan(file))
+                System.out.println(file + ":" + symbol);
+        }
+    }
+
+    private static void query(ApiIndex index, String query) {
+        int colon = query.indexOf(':');
+        String kind = colon < 0 ? "" : query.substring(0, colon);
+        String name = query.substring(colon + 1);
+        System.out.println(query + ":");
+        if (kind.equals("base") || kind.equals("attribute") || kind.equals("namespace")) {
+            List<ApiModel.ClassInfo> classes = kind.equals("base") ? index.getClassesWithBase(name)
+                    : kind.equals("attribute") ? index.getClassesWithAttribute(name) : index.getClassesIn(name);
+            for (ApiModel.ClassInfo cls : classes)
+                System.out.println("    " + index.getFile(cls) + ": " + cls);
+        } else if (kind.equals("property")) {
+            for (ApiIndex.Property property : index.getPropertiesOfType(name))
+                System.out.println("    " + index.getFile(property.getOwner()) + ": " + property);
+        } else if (kind.equals("enums")) {
+            for (ApiModel.EnumInfo e : index.getEnumsIn(name))
+                System.out.println("    " + index.getFile(e) + ": " + e);
+        } else {
+            System.err.println("unknown query kind: " + kind);
+        }
+    }
 
+    private static void print(ApiModel model) {
+        for (ApiModel.ClassInfo cls : model.getClasses()) {
+            System.out.println(cls);
+            for (ApiModel.PropertyInfo property : cls.getProperties())
+                System.out.println("    " + property);
+        }
+        for (ApiModel.EnumInfo e : model.getEnums())
+            System.out.println(e);
     }
 }
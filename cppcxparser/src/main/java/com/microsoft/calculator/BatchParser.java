@@ -0,0 +1,696 @@
+package com.microsoft.calculator;
+
+import java.io.ByteArrayInputStream;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.FileVisitResult;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.SimpleFileVisitor;
+import java.nio.file.attribute.BasicFileAttributes;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+import java.util.Locale;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+import com.microsoft.CPPCXParser.TranslationUnitContext;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenFactory;
+import org.antlr.v4.runtime.Lexer;
+import org.antlr.v4.runtime.TokenFactory;
+import org.antlr.v4.runtime.TokenSource;
+
+/**
+ * Parses many translation units on a fixed thread pool.
+ *
+ * Every worker thread owns one lexer, token stream and parser and resets them
+ * for each file and extracts an {@link ApiModel} with {@link ApiModelBuilder};
+ * preprocessor directives go to a {@link DirectiveIndex} instead of the token
+ * buffer. Only the prediction DFA, which ANTLR synchronizes itself, is
+ * shared between workers. Results are returned in the order the files were
+ * given.
+ */
+public class BatchParser {
+
+    public static final List<String> SOURCE_EXTENSIONS = Arrays.asList(".cpp", ".cxx", ".cc", ".h", ".hpp", ".hxx",
+            ".inl");
+
+    private final int threads;
+    private final TwoStageParser twoStage = new TwoStageParser();
+    private boolean streaming;
+    private boolean skipBodies;
+    private MacroTable macros;
+    private ParseCache cache;
+    private ParseStats stats;
+    private InterningTokenFactory.TextTable tokenTexts;
+    private int maxErrors;
+    private long timeoutMillis;
+    private boolean degradeOnTimeout;
+    private int chunkTokens;
+    private boolean keywordLexer;
+    private boolean treeless;
+    private boolean mapFiles = true;
+    private volatile ChunkedParser chunked;
+    private final InterningTokenFactory.Counts tokenCounts = new InterningTokenFactory.Counts();
+
+    private final ThreadLocal<Worker> workers = new ThreadLocal<Worker>() {
+        @Override
+        protected Worker initialValue() {
+            return new Worker();
+        }
+    };
+
+    public BatchParser(int threads) {
+        if (threads < 1)
+            throw new IllegalArgumentException("threads must be positive: " + threads);
+        this.threads = threads;
+    }
+
+    public TwoStageParser getTwoStageParser() {
+        return twoStage;
+    }
+
+    /**
+     * Parses files with {@link StreamingParser} so that no file's tree is kept
+     * in memory as a whole.
+     */
+    public void setStreaming(boolean streaming) {
+        this.streaming = streaming;
+    }
+
+    /**
+     * Parses function bodies as empty, see {@link SkipBodyTokenSource}.
+     */
+    public void setSkipBodies(boolean skipBodies) {
+        this.skipBodies = skipBodies;
+    }
+
+    /**
+     * Expands the macros of the table before parsing, see
+     * {@link MacroExpandingTokenSource}.
+     */
+    public void setMacros(MacroTable macros) {
+        this.macros = macros;
+    }
+
+    /**
+     * Takes the models of unchanged files from the cache and stores the
+     * models of files that parsed without errors.
+     */
+    public void setCache(ParseCache cache) {
+        this.cache = cache;
+    }
+
+    public ParseCache getCache() {
+        return cache;
+    }
+
+    /**
+     * Measures every parsed file and profiles the parser's decisions, which
+     * slows parsing down.
+     */
+    public void setStats(ParseStats stats) {
+        this.stats = stats;
+    }
+
+    public ParseStats getStats() {
+        return stats;
+    }
+
+    /**
+     * Aborts the parse of a file after the time, see
+     * {@link CancellableTokenStream}, and records it as timed out; 0 for no
+     * limit. Does not apply to streaming.
+     */
+    public void setTimeout(long timeoutMillis) {
+        if (timeoutMillis < 0)
+            throw new IllegalArgumentException("timeout must not be negative: " + timeoutMillis);
+        this.timeoutMillis = timeoutMillis;
+    }
+
+    public long getTimeout() {
+        return timeoutMillis;
+    }
+
+    /**
+     * Parses a file that timed out once more with function bodies skipped,
+     * which is usually where the lookahead blew up, and marks the result as
+     * degraded.
+     */
+    public void setDegradeOnTimeout(boolean degradeOnTimeout) {
+        this.degradeOnTimeout = degradeOnTimeout;
+    }
+
+    /**
+     * Recovers from syntax errors with a {@link DeclarationRecoveryStrategy}
+     * that skips the rest of a file after {@code maxErrors} errors, and
+     * collects them as {@link FileResult#getDiagnostics} instead of printing
+     * them; 0 keeps ANTLR's default recovery. Does not apply to streaming.
+     */
+    public void setMaxErrors(int maxErrors) {
+        if (maxErrors < 0)
+            throw new IllegalArgumentException("maxErrors must not be negative: " + maxErrors);
+        this.maxErrors = maxErrors;
+    }
+
+    /**
+     * Parses files of at least twice the tokens in chunks of at least that
+     * many tokens on a second pool of the same size, see
+     * {@link ChunkedParser}, so that one large file can use all threads; 0
+     * parses every file as a whole. Does not apply to streaming or with
+     * stats. The timeout covers the chunks of a file as it covers the file.
+     */
+    public void setChunkTokens(int chunkTokens) {
+        if (chunkTokens < 0)
+            throw new IllegalArgumentException("chunkTokens must not be negative: " + chunkTokens);
+        this.chunkTokens = chunkTokens;
+    }
+
+    /**
+     * Lexes with a {@link KeywordLexer}, which produces the same tokens with
+     * a smaller DFA. Does not apply to streaming. Set before parsing.
+     */
+    public void setKeywordLexer(boolean keywordLexer) {
+        this.keywordLexer = keywordLexer;
+    }
+
+    /**
+     * Extracts the model during the parse without building the tree, see
+     * {@link TreelessExtractor}, so that a worker retains little more than
+     * the tokens of its file. Does not apply to streaming or chunks. Set
+     * before parsing.
+     */
+    public void setTreeless(boolean treeless) {
+        this.treeless = treeless;
+    }
+
+    /**
+     * Reads files through memory mappings, the default, or into the heap. A
+     * mapping is only released when it is collected, and on Windows the
+     * file cannot be replaced until then, so an editor could not save a
+     * file that is being watched.
+     */
+    public void setMapFiles(boolean mapFiles) {
+        this.mapFiles = mapFiles;
+    }
+
+    /**
+     * Interns token texts in one table for all files and reuses the tokens
+     * of each worker's previous file, see {@link InterningTokenFactory}.
+     * Does not apply to streaming.
+     */
+    public void setPoolTokens(boolean poolTokens) {
+        tokenTexts = poolTokens ? new InterningTokenFactory.TextTable() : null;
+    }
+
+    /**
+     * The token factory counts of all files parsed so far, or null without
+     * token pooling.
+     */
+    public InterningTokenFactory.Counts getTokenCounts() {
+        if (tokenTexts == null)
+            return null;
+        InterningTokenFactory.Counts counts = new InterningTokenFactory.Counts();
+        synchronized (tokenCounts) {
+            counts.add(tokenCounts);
+        }
+        return counts;
+    }
+
+    /**
+     * Expands directories into the C++/CX sources below them, sorted by path.
+     * Plain files are kept as given.
+     */
+    public static List<Path> collectSources(List<Path> roots) throws IOException {
+        final List<Path> sources = new ArrayList<>();
+        for (Path root : roots) {
+            if (!Files.isDirectory(root)) {
+                sources.add(root);
+                continue;
+            }
+            final List<Path> found = new ArrayList<>();
+            Files.walkFileTree(root, new SimpleFileVisitor<Path>() {
+                @Override
+                public FileVisitResult visitFile(Path file, BasicFileAttributes attrs) {
+                    if (attrs.isRegularFile() && isSource(file))
+                        found.add(file);
+                    return FileVisitResult.CONTINUE;
+                }
+            });
+            Collections.sort(found);
+            sources.addAll(found);
+        }
+        return sources;
+    }
+
+    public static boolean isSource(Path file) {
+        String name = file.getFileName().toString().toLowerCase(Locale.ROOT);
+        for (String extension : SOURCE_EXTENSIONS) {
+            if (name.endsWith(extension))
+                return true;
+        }
+        return false;
+    }
+
+    public BatchResult parse(List<Path> files) throws InterruptedException {
+        ExecutorService pool = Executors.newFixedThreadPool(threads);
+        ExecutorService chunkPool = chunkTokens > 0 ? Executors.newFixedThreadPool(threads) : null;
+        if (chunkPool != null) {
+            chunked = new ChunkedParser(chunkPool, twoStage);
+            chunked.setChunkTokens(chunkTokens);
+        }
+        try {
+            List<Future<FileResult>> futures = new ArrayList<>(files.size());
+            for (final Path file : files) {
+                futures.add(pool.submit(new Callable<FileResult>() {
+                    @Override
+                    public FileResult call() {
+                        return workers.get().parse(file);
+                    }
+                }));
+            }
+
+            List<FileResult> results = new ArrayList<>(files.size());
+            for (int i = 0; i < files.size(); i++) {
+                try {
+                    results.add(futures.get(i).get());
+                } catch (ExecutionException e) {
+                    results.add(FileResult.failed(files.get(i), e.getCause()));
+                }
+            }
+            return new BatchResult(results);
+        } finally {
+            pool.shutdownNow();
+            if (chunkPool != null) {
+                chunked = null;
+                chunkPool.shutdownNow();
+            }
+        }
+    }
+
+    private class Worker {
+        private final CharStream empty = CharStreams.fromString("");
+        private final Lexer lexer = keywordLexer ? new KeywordLexer(empty) : new CPPCXLexer(empty);
+        private final CancellableTokenStream tokens = new CancellableTokenStream(lexer);
+        private final CPPCXParser parser = new CPPCXParser(tokens);
+        private final TreelessExtractor extractor = treeless ? new TreelessExtractor(parser) : null;
+        private final StreamingParser streamingParser = new StreamingParser(twoStage);
+        private InterningTokenFactory tokenFactory;
+
+        FileResult parse(Path file) {
+            try {
+                return parseFile(file);
+            } finally {
+                release();
+            }
+        }
+
+        private FileResult parseFile(Path file) {
+            if (cache == null && mapFiles)
+                return streaming ? parseStreaming(file, null) : parseOrDegrade(file, null);
+
+            byte[] content;
+            try {
+                content = Files.readAllBytes(file);
+            } catch (IOException e) {
+                return FileResult.failed(file, e);
+            }
+            if (cache == null)
+                return streaming ? parseStreaming(file, content) : parseOrDegrade(file, content);
+            ApiModel cached = cache.get(content);
+            if (cached != null)
+                return new FileResult(file, 0, cached, null);
+
+            FileResult result = streaming ? parseStreaming(file, content) : parseOrDegrade(file, content);
+            if (result.getFailure() == null && result.getSyntaxErrors() == 0 && !result.isDegraded()) {
+                try {
+                    cache.put(content, result.getModel());
+                } catch (IOException e) {
+                    // The cache only saves time; the result is still valid.
+                }
+            }
+            return result;
+        }
+
+        FileResult parseOrDegrade(Path file, byte[] content) {
+            FileResult result = parseTree(file, content, skipBodies);
+            if (!result.isTimedOut() || !degradeOnTimeout || skipBodies)
+                return result;
+            FileResult degraded = parseTree(file, content, true);
+            return degraded.isTimedOut() ? degraded : degraded.degraded();
+        }
+
+        /**
+         * Parses the file, or its content if already read.
+         */
+        FileResult parseTree(Path file, byte[] content, boolean skipBodies) {
+            ParseStats.FileStats fileStats = stats == null ? null : new ParseStats.FileStats(file);
+            long allocated = stats == null ? 0 : ParseStats.allocatedBytes();
+            long start = System.nanoTime();
+            lexer.setTokenFactory(nextTokenFactory());
+            try {
+                lexer.setInputStream(content == null ? MappedCharStream.fromPath(file)
+                        : new MappedCharStream(ByteBuffer.wrap(content), file.toString()));
+            } catch (IOException e) {
+                return FileResult.failed(file, e);
+            }
+            DirectiveTokenSource directives = new DirectiveTokenSource(lexer);
+            TokenSource source = directives;
+            if (macros != null)
+                source = new MacroExpandingTokenSource(source, macros);
+            if (skipBodies)
+                source = new SkipBodyTokenSource(source);
+            tokens.setTokenSource(source);
+            parser.setInputStream(tokens);
+            DiagnosticCollector diagnostics = maxErrors > 0 ? collectDiagnostics() : null;
+            tokens.setTimeout(timeoutMillis);
+            if (fileStats != null) {
+                // A fresh profiling simulator per file, sharing the DFA.
+                parser.setProfile(false);
+                parser.setProfile(true);
+                tokens.fill();
+                fileStats.lexNanos = System.nanoTime() - start;
+                start = System.nanoTime();
+            }
+
+            ChunkedParser chunks = fileStats == null ? chunked : null;
+            ApiModel model = null;
+            TranslationUnitContext tu = null;
+            try {
+                if (chunks != null)
+                    model = parseChunked(chunks);
+            } catch (ParseTimeoutException e) {
+                countTokens();
+                return FileResult.failed(file, e);
+            }
+            if (model == null) {
+                try {
+                    tu = twoStage.parse(parser);
+                } catch (ParseTimeoutException e) {
+                    countTokens();
+                    return FileResult.failed(file, e);
+                }
+                if (fileStats != null) {
+                    fileStats.parseNanos = System.nanoTime() - start;
+                    start = System.nanoTime();
+                }
+                model = extractor != null ? extractor.getModel() : ApiModelBuilder.build(tu);
+            }
+            int syntaxErrors = parser.getNumberOfSyntaxErrors();
+
+            if (fileStats != null) {
+                fileStats.walkNanos = System.nanoTime() - start;
+                fileStats.tokens = tokens.size();
+                fileStats.nodes = ParseStats.countNodes(tu);
+                fileStats.syntaxErrors = syntaxErrors;
+                fileStats.allocatedBytes = allocated < 0 ? -1 : ParseStats.allocatedBytes() - allocated;
+                stats.addFile(fileStats);
+                stats.addDecisions(parser.getParseInfo().getDecisionInfo());
+            }
+            countTokens();
+            FileResult result = diagnostics == null ? new FileResult(file, syntaxErrors, model, null)
+                    : new FileResult(file, syntaxErrors, model, null, diagnostics.getDiagnostics(),
+                            ((DeclarationRecoveryStrategy) parser.getErrorHandler()).isTruncated());
+            return result.withDirectives(directives.getIndex());
+        }
+
+        /**
+         * The model of a large file parsed in chunks, or null to parse it as
+         * a whole.
+         */
+        private ApiModel parseChunked(ChunkedParser chunks) {
+            tokens.fill();
+            if (tokens.size() < 2 * chunks.getChunkTokens())
+                return null;
+            CxListener listener = new CxListener();
+            try {
+                return chunks.parse(tokens.getTokens(), listener, tokens) ? listener.getModel() : null;
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                return null;
+            }
+        }
+
+        /**
+         * Switches the lexer and parser to diagnostics for the next file.
+         */
+        private DiagnosticCollector collectDiagnostics() {
+            if (!(parser.getErrorHandler() instanceof DeclarationRecoveryStrategy)
+                    || ((DeclarationRecoveryStrategy) parser.getErrorHandler()).getMaxErrors() != maxErrors)
+                parser.setErrorHandler(new DeclarationRecoveryStrategy(maxErrors));
+            DiagnosticCollector diagnostics = new DiagnosticCollector();
+            lexer.removeErrorListeners();
+            lexer.addErrorListener(diagnostics);
+            parser.removeErrorListeners();
+            parser.addErrorListener(diagnostics);
+            return diagnostics;
+        }
+
+        /**
+         * Drops the references to the file just parsed, so that the lexer,
+         * token buffer and pooled tokens do not keep its input, such as a
+         * mapping, until the next file.
+         */
+        private void release() {
+            if (tokenFactory != null)
+                tokenFactory.release();
+            lexer.setInputStream(empty);
+            tokens.setTokenSource(lexer);
+            parser.setInputStream(tokens);
+        }
+
+        /**
+         * The factory for the next file, with the tokens of the previous
+         * file, which is no longer referenced, released.
+         */
+        private TokenFactory<?> nextTokenFactory() {
+            if (tokenTexts == null)
+                return CommonTokenFactory.DEFAULT;
+            if (tokenFactory == null)
+                tokenFactory = new InterningTokenFactory(tokenTexts);
+            tokenFactory.reset();
+            return tokenFactory;
+        }
+
+        private void countTokens() {
+            if (tokenFactory == null)
+                return;
+            synchronized (tokenCounts) {
+                tokenCounts.add(tokenFactory.getCounts());
+            }
+            tokenFactory.getCounts().clear();
+        }
+
+        FileResult parseStreaming(Path file, byte[] content) {
+            streamingParser.setSkipBodies(skipBodies);
+            streamingParser.setMacros(macros);
+            CxListener listener = new CxListener();
+            long allocated = stats == null ? 0 : ParseStats.allocatedBytes();
+            long start = System.nanoTime();
+            int syntaxErrors;
+            try {
+                syntaxErrors = content == null ? streamingParser.parse(file, listener)
+                        : streamingParser.parse(new InputStreamReader(new ByteArrayInputStream(content),
+                                StandardCharsets.UTF_8), file.toString(), listener);
+            } catch (IOException e) {
+                return FileResult.failed(file, e);
+            }
+            if (stats != null) {
+                ParseStats.FileStats fileStats = new ParseStats.FileStats(file);
+                fileStats.parseNanos = System.nanoTime() - start;
+                fileStats.tokens = -1;
+                fileStats.nodes = -1;
+                fileStats.syntaxErrors = syntaxErrors;
+                fileStats.allocatedBytes = allocated < 0 ? -1 : ParseStats.allocatedBytes() - allocated;
+                stats.addFile(fileStats);
+            }
+            return new FileResult(file, syntaxErrors, listener.getModel(), null);
+        }
+    }
+
+    /**
+     * Extraction result of one file.
+     */
+    public static class FileResult {
+        private final Path file;
+        private final int syntaxErrors;
+        private final ApiModel model;
+        private final Throwable failure;
+        private final List<DiagnosticCollector.Diagnostic> diagnostics;
+        private final boolean truncated;
+        private final boolean degraded;
+        private final DirectiveIndex directives;
+
+        FileResult(Path file, int syntaxErrors, ApiModel model, Throwable failure) {
+            this(file, syntaxErrors, model, failure, Collections.<DiagnosticCollector.Diagnostic>emptyList(), false);
+        }
+
+        FileResult(Path file, int syntaxErrors, ApiModel model, Throwable failure,
+                List<DiagnosticCollector.Diagnostic> diagnostics, boolean truncated) {
+            this(file, syntaxErrors, model, failure, diagnostics, truncated, false, null);
+        }
+
+        private FileResult(Path file, int syntaxErrors, ApiModel model, Throwable failure,
+                List<DiagnosticCollector.Diagnostic> diagnostics, boolean truncated, boolean degraded,
+                DirectiveIndex directives) {
+            this.file = file;
+            this.syntaxErrors = syntaxErrors;
+            this.model = model;
+            this.failure = failure;
+            this.diagnostics = diagnostics;
+            this.truncated = truncated;
+            this.degraded = degraded;
+            this.directives = directives;
+        }
+
+        FileResult degraded() {
+            return new FileResult(file, syntaxErrors, model, failure, diagnostics, truncated, true, directives);
+        }
+
+        FileResult withDirectives(DirectiveIndex directives) {
+            return new FileResult(file, syntaxErrors, model, failure, diagnostics, truncated, degraded, directives);
+        }
+
+        static FileResult failed(Path file, Throwable failure) {
+            return new FileResult(file, 0, new ApiModel(), failure);
+        }
+
+        public Path getFile() {
+            return file;
+        }
+
+        public int getSyntaxErrors() {
+            return syntaxErrors;
+        }
+
+        public ApiModel getModel() {
+            return model;
+        }
+
+        /**
+         * The exception that stopped the file from being parsed, or null.
+         */
+        public Throwable getFailure() {
+            return failure;
+        }
+
+        /**
+         * The syntax errors of the file with {@link BatchParser#setMaxErrors},
+         * empty otherwise.
+         */
+        public List<DiagnosticCollector.Diagnostic> getDiagnostics() {
+            return diagnostics;
+        }
+
+        /**
+         * The include, pragma once and define directives of the file, or null
+         * if it was streamed, taken from the cache or not parsed.
+         */
+        public DirectiveIndex getDirectives() {
+            return directives;
+        }
+
+        /**
+         * Whether parsing stopped early after too many errors.
+         */
+        public boolean isTruncated() {
+            return truncated;
+        }
+
+        /**
+         * Whether the parse ran out of time, see {@link BatchParser#setTimeout}.
+         */
+        public boolean isTimedOut() {
+            return failure instanceof ParseTimeoutException;
+        }
+
+        /**
+         * Whether the file timed out and was parsed again with function bodies
+         * skipped.
+         */
+        public boolean isDegraded() {
+            return degraded;
+        }
+    }
+
+    /**
+     * Results of all files of a batch, merged in input order.
+     */
+    public static class BatchResult {
+        private final List<FileResult> files;
+
+        BatchResult(List<FileResult> files) {
+            this.files = Collections.unmodifiableList(files);
+        }
+
+        public List<FileResult> getFiles() {
+            return files;
+        }
+
+        /**
+         * The models of all files merged into one.
+         */
+        public ApiModel getModel() {
+            ApiModel model = new ApiModel();
+            for (FileResult file : files)
+                model.merge(file.getModel());
+            return model;
+        }
+
+        /**
+         * The models of all files in an {@link ApiIndex}.
+         */
+        public ApiIndex getIndex() {
+            ApiIndex index = new ApiIndex();
+            for (FileResult file : files)
+                index.put(file.getFile(), file.getModel());
+            return index;
+        }
+
+        public int getFailureCount() {
+            int count = 0;
+            for (FileResult file : files) {
+                if (file.getFailure() != null)
+                    count++;
+            }
+            return count;
+        }
+
+        public int getTimeoutCount() {
+            int count = 0;
+            for (FileResult file : files) {
+                if (file.isTimedOut())
+                    count++;
+            }
+            return count;
+        }
+
+        public int getDegradedCount() {
+            int count = 0;
+            for (FileResult file : files) {
+                if (file.isDegraded())
+                    count++;
+            }
+            return count;
+        }
+
+        public int getSyntaxErrorCount() {
+            int count = 0;
+            for (FileResult file : files)
+                count += file.getSyntaxErrors();
+            return count;
+        }
+    }
+}
@@ -0,0 +1,82 @@
+package com.microsoft.calculator;
+
+import java.util.concurrent.TimeUnit;
+
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.TokenSource;
+
+/**
+ * A token stream that aborts the parse reading from it with a
+ * {@link ParseTimeoutException} once a deadline has passed, the parse was
+ * cancelled or the thread was interrupted.
+ *
+ * Prediction reads tokens ahead through {@link #LT} however deep its
+ * lookahead goes, so checking there bounds even exponential lookahead. The
+ * clock is only read every {@value #CHECK_INTERVAL} reads. Lexing a single
+ * token is not interrupted, which is cheap in this lexer.
+ */
+public class CancellableTokenStream extends CommonTokenStream {
+
+    static final int CHECK_INTERVAL = 1024;
+
+    private long started;
+    private long deadline;
+    private boolean limited;
+    private volatile boolean cancelled;
+    private int reads;
+
+    public CancellableTokenStream(TokenSource tokenSource) {
+        super(tokenSource);
+        started = System.nanoTime();
+    }
+
+    /**
+     * Starts the clock for the next parse and forgets an earlier
+     * {@link #cancel}. A timeout of 0 means no limit.
+     */
+    public void setTimeout(long timeoutMillis) {
+        started = System.nanoTime();
+        limited = timeoutMillis > 0;
+        deadline = started + TimeUnit.MILLISECONDS.toNanos(timeoutMillis);
+        cancelled = false;
+        reads = 0;
+    }
+
+    /**
+     * Gives the next parse the deadline of the current parse of another
+     * stream, such as that of the whole file for one of its chunks, and
+     * forgets an earlier {@link #cancel}.
+     */
+    public void setDeadline(CancellableTokenStream other) {
+        started = other.started;
+        limited = other.limited;
+        deadline = other.deadline;
+        cancelled = false;
+        reads = 0;
+    }
+
+    /**
+     * Makes the current parse fail at its next token read. May be called
+     * from any thread.
+     */
+    public void cancel() {
+        cancelled = true;
+    }
+
+    @Override
+    public Token LT(int k) {
+        if (cancelled || ++reads >= CHECK_INTERVAL)
+            check();
+        return super.LT(k);
+    }
+
+    private void check() {
+        reads = 0;
+        long now = System.nanoTime();
+        boolean interrupted = cancelled || Thread.currentThread().isInterrupted();
+        if (interrupted || limited && now - deadline > 0)
+            throw new ParseTimeoutException(getSourceName(), TimeUnit.NANOSECONDS.toMillis(now - started),
+                    interrupted);
+    }
+}
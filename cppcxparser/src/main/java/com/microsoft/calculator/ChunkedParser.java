@@ -0,0 +1,405 @@
+package com.microsoft.calculator;
+
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Deque;
+import java.util.Iterator;
+import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Future;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+import com.microsoft.CPPCXParser.DeclarationContext;
+import com.microsoft.CPPCXParser.DeclarationseqContext;
+
+import org.antlr.v4.runtime.BailErrorStrategy;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.ListTokenSource;
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.WritableToken;
+import org.antlr.v4.runtime.misc.ParseCancellationException;
+
+/**
+ * Parses the tokens of one large file in chunks on several threads.
+ *
+ * The tokens are split where a top-level declaration, or one directly in a
+ * namespace body, certainly ends: after a {@code ;} outside parentheses and
+ * braces, or after the closing brace of a function body or linkage
+ * specification that nothing continues. Namespace headers and their closing
+ * braces are matched here as in {@link StreamingParser} and never belong to a
+ * chunk. Consecutive declarations are grouped into chunks of at least
+ * {@link #setChunkTokens} tokens, each parsed as a {@code declarationseq} by
+ * a parser of the executor's thread. The declarations and namespaces are
+ * then handed to the {@link StreamingParser.Handler} in source order on the
+ * calling thread.
+ *
+ * The split is a lexical guess, so a chunk that does not parse cleanly may
+ * have been cut in the wrong place. Nothing is handed to the handler then
+ * and the caller parses the file as a whole, which also reports the errors.
+ * The tokens keep the indices of the whole file.
+ *
+ * Each chunk is read through a {@link CancellableTokenStream} with the
+ * deadline of the file's stream, so a chunk that runs past it ends the
+ * parse with a {@link ParseTimeoutException}. When the calling thread is
+ * interrupted, the chunks are cancelled and waited for before the tokens
+ * are renumbered, since they renumber the same tokens while they parse.
+ */
+public class ChunkedParser {
+
+    public static final int DEFAULT_CHUNK_TOKENS = 4096;
+
+    private final ExecutorService executor;
+    private final TwoStageParser twoStage;
+    private int chunkTokens = DEFAULT_CHUNK_TOKENS;
+
+    private final ThreadLocal<CPPCXParser> parsers = new ThreadLocal<CPPCXParser>() {
+        @Override
+        protected CPPCXParser initialValue() {
+            CPPCXParser parser = new CPPCXParser(null);
+            parser.removeErrorListeners();
+            parser.setErrorHandler(new BailErrorStrategy());
+            return parser;
+        }
+    };
+
+    public ChunkedParser(ExecutorService executor, TwoStageParser twoStage) {
+        this.executor = executor;
+        this.twoStage = twoStage;
+    }
+
+    public int getChunkTokens() {
+        return chunkTokens;
+    }
+
+    /**
+     * The least number of tokens, hidden ones included, that are parsed as
+     * one chunk.
+     */
+    public void setChunkTokens(int chunkTokens) {
+        if (chunkTokens < 1)
+            throw new IllegalArgumentException("chunkTokens must be positive: " + chunkTokens);
+        this.chunkTokens = chunkTokens;
+    }
+
+    /**
+     * Parses the tokens of a file, ending with EOF, such as those of a filled
+     * {@link CommonTokenStream}.
+     *
+     * @return false, without calling the handler, if the tokens make fewer
+     *         than two chunks or a chunk did not parse cleanly
+     */
+    public boolean parse(List<Token> tokens, StreamingParser.Handler handler) throws InterruptedException {
+        return parse(tokens, handler, null);
+    }
+
+    /**
+     * Parses the tokens of a file within the deadline of the file's stream,
+     * or without one if it is null.
+     *
+     * @return false, without calling the handler, if the tokens make fewer
+     *         than two chunks or a chunk did not parse cleanly
+     * @throws ParseTimeoutException if a chunk runs past the deadline
+     */
+    public boolean parse(List<Token> tokens, StreamingParser.Handler handler, CancellableTokenStream file)
+            throws InterruptedException {
+        List<Segment> segments = split(tokens, chunkTokens);
+        if (segments == null || chunkCount(segments) < 2)
+            return false;
+        List<CancellableTokenStream> streams = new ArrayList<>();
+        List<Future<DeclarationseqContext>> futures = new ArrayList<>();
+        for (Segment segment : segments) {
+            if (segment.kind != Segment.Kind.CHUNK)
+                continue;
+            final CancellableTokenStream stream = new CancellableTokenStream(
+                    new ListTokenSource(tokens.subList(segment.start, segment.stop)));
+            if (file != null)
+                stream.setDeadline(file);
+            streams.add(stream);
+            futures.add(executor.submit(new Callable<DeclarationseqContext>() {
+                @Override
+                public DeclarationseqContext call() {
+                    return parseChunk(stream);
+                }
+            }));
+        }
+
+        List<DeclarationseqContext> chunks = new ArrayList<>(futures.size());
+        Throwable failure = null;
+        boolean interrupted = false;
+        try {
+            // Wait for every chunk, even when interrupted, so none still renumbers tokens below.
+            for (Future<DeclarationseqContext> future : futures) {
+                while (true) {
+                    try {
+                        chunks.add(future.get());
+                        break;
+                    } catch (InterruptedException e) {
+                        if (!interrupted) {
+                            interrupted = true;
+                            for (CancellableTokenStream stream : streams)
+                                stream.cancel();
+                        }
+                    } catch (ExecutionException e) {
+                        if (failure == null)
+                            failure = e.getCause();
+                        break;
+                    }
+                }
+            }
+        } finally {
+            for (int i = 0; i < tokens.size(); i++) {
+                if (tokens.get(i) instanceof WritableToken)
+                    ((WritableToken) tokens.get(i)).setTokenIndex(i);
+            }
+        }
+        if (interrupted)
+            throw new InterruptedException("chunked parse interrupted");
+        if (failure instanceof RuntimeException)
+            throw (RuntimeException) failure;
+        if (failure instanceof Error)
+            throw (Error) failure;
+        if (failure != null)
+            throw new IllegalStateException(failure);
+        if (chunks.contains(null))
+            return false;
+
+        Iterator<DeclarationseqContext> chunk = chunks.iterator();
+        for (Segment segment : segments) {
+            switch (segment.kind) {
+            case ENTER:
+                handler.enterNamespace(segment.name);
+                break;
+            case EXIT:
+                handler.exitNamespace(segment.name);
+                break;
+            default:
+                for (DeclarationContext declaration : chunk.next().declaration())
+                    handler.declaration(declaration);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @return the chunk's declarations, or null if it did not parse cleanly
+     */
+    private DeclarationseqContext parseChunk(CancellableTokenStream chunk) {
+        CPPCXParser parser = parsers.get();
+        parser.setInputStream(chunk);
+        try {
+            DeclarationseqContext declarations = twoStage.parse(parser, TwoStageParser.DECLARATION_SEQ);
+            return parser.getInputStream().LA(1) == Token.EOF ? declarations : null;
+        } catch (ParseTimeoutException e) {
+            throw e;
+        } catch (ParseCancellationException e) {
+            return null;
+        } finally {
+            parser.setTokenStream(null);
+        }
+    }
+
+    private static int chunkCount(List<Segment> segments) {
+        int count = 0;
+        for (Segment segment : segments) {
+            if (segment.kind == Segment.Kind.CHUNK)
+                count++;
+        }
+        return count;
+    }
+
+    /**
+     * Splits the tokens into chunks and namespace boundaries in source order.
+     *
+     * @return null if the namespace braces do not balance
+     */
+    static List<Segment> split(List<? extends Token> tokens, int chunkTokens) {
+        List<Segment> segments = new ArrayList<>();
+        Deque<String> namespaces = new ArrayDeque<>();
+        int end = tokens.size();
+        if (end > 0 && tokens.get(end - 1).getType() == Token.EOF)
+            end--;
+        int chunkStart = 0;
+        boolean pending = false;
+        boolean inDeclaration = false;
+        int braces = 0;
+        int parens = 0;
+        boolean bodyBraces = false;
+        int previous = Token.INVALID_TYPE;
+        for (int i = 0; i < end; i++) {
+            Token token = tokens.get(i);
+            if (token.getChannel() != Token.DEFAULT_CHANNEL)
+                continue;
+            int type = token.getType();
+            if (!inDeclaration) {
+                StringBuilder name = new StringBuilder();
+                int body = namespaceBody(tokens, i, end, name);
+                if (body >= 0) {
+                    flush(segments, chunkStart, i, pending);
+                    segments.add(new Segment(Segment.Kind.ENTER, name.toString(), i, body));
+                    namespaces.push(name.toString());
+                    chunkStart = body;
+                    pending = false;
+                    previous = CPPCXLexer.LeftBrace;
+                    i = body - 1;
+                    continue;
+                }
+                if (type == CPPCXLexer.RightBrace) {
+                    if (namespaces.isEmpty())
+                        return null;
+                    flush(segments, chunkStart, i, pending);
+                    segments.add(new Segment(Segment.Kind.EXIT, namespaces.pop(), i, i + 1));
+                    chunkStart = i + 1;
+                    pending = false;
+                    previous = type;
+                    continue;
+                }
+                inDeclaration = true;
+                pending = true;
+            }
+
+            boolean ended = false;
+            if (type == CPPCXLexer.LeftBrace) {
+                if (braces++ == 0)
+                    bodyBraces = parens == 0 && endsAtBody(previous);
+            } else if (type == CPPCXLexer.RightBrace) {
+                if (--braces < 0)
+                    return null;
+                ended = braces == 0 && bodyBraces
+                        && !continuesAfterBody(typeAt(tokens, nextIndex(tokens, i, end), end));
+            } else if (braces == 0) {
+                if (type == CPPCXLexer.LeftParen)
+                    parens++;
+                else if (type == CPPCXLexer.RightParen)
+                    parens--;
+                else if (type == CPPCXLexer.Semi)
+                    ended = parens == 0;
+            }
+            previous = type;
+            if (ended) {
+                inDeclaration = false;
+                bodyBraces = false;
+                if (i + 1 - chunkStart >= chunkTokens) {
+                    segments.add(new Segment(Segment.Kind.CHUNK, null, chunkStart, i + 1));
+                    chunkStart = i + 1;
+                    pending = false;
+                }
+            }
+        }
+        if (!namespaces.isEmpty())
+            return null;
+        flush(segments, chunkStart, end, pending);
+        return segments;
+    }
+
+    private static void flush(List<Segment> segments, int start, int stop, boolean pending) {
+        if (pending)
+            segments.add(new Segment(Segment.Kind.CHUNK, null, start, stop));
+    }
+
+    /**
+     * Whether braces after the token open a function body or linkage
+     * specification rather than a class, enum or initializer.
+     */
+    private static boolean endsAtBody(int previous) {
+        switch (previous) {
+        case CPPCXLexer.RightParen:
+        case CPPCXLexer.Const:
+        case CPPCXLexer.Volatile:
+        case CPPCXLexer.Noexcept:
+        case CPPCXLexer.StringLiteral:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * Whether the token after braces continues the declaration, as after a
+     * lambda.
+     */
+    private static boolean continuesAfterBody(int next) {
+        switch (next) {
+        case CPPCXLexer.Semi:
+        case CPPCXLexer.Comma:
+        case CPPCXLexer.LeftParen:
+        case CPPCXLexer.RightParen:
+        case CPPCXLexer.LeftBracket:
+        case CPPCXLexer.Dot:
+        case CPPCXLexer.Arrow:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * Matches an {@code inline? namespace name?} header and its opening brace
+     * at the token.
+     *
+     * @return the index after the brace, or -1 if no namespace body starts
+     *         here
+     */
+    private static int namespaceBody(List<? extends Token> tokens, int i, int end, StringBuilder name) {
+        int type = tokens.get(i).getType();
+        if (type == CPPCXLexer.Inline) {
+            i = nextIndex(tokens, i, end);
+            type = typeAt(tokens, i, end);
+        }
+        if (type != CPPCXLexer.Namespace)
+            return -1;
+        while (true) {
+            i = nextIndex(tokens, i, end);
+            type = typeAt(tokens, i, end);
+            if (type != CPPCXLexer.Identifier && type != CPPCXLexer.Doublecolon)
+                break;
+            name.append(tokens.get(i).getText());
+        }
+        return type == CPPCXLexer.LeftBrace ? i + 1 : -1;
+    }
+
+    /**
+     * The index of the next default channel token, or the end.
+     */
+    private static int nextIndex(List<? extends Token> tokens, int i, int end) {
+        for (i++; i < end; i++) {
+            if (tokens.get(i).getChannel() == Token.DEFAULT_CHANNEL)
+                return i;
+        }
+        return end;
+    }
+
+    private static int typeAt(List<? extends Token> tokens, int i, int end) {
+        return i < end ? tokens.get(i).getType() : Token.EOF;
+    }
+
+    /**
+     * A chunk of declarations or a namespace boundary, as a range of token
+     * indices.
+     */
+    static class Segment {
+        enum Kind {
+            ENTER, CHUNK, EXIT
+        }
+
+        final Kind kind;
+        /** The namespace name of a boundary. */
+        final String name;
+        final int start;
+        final int stop;
+
+        Segment(Kind kind, String name, int start, int stop) {
+            this.kind = kind;
+            this.name = name;
+            this.start = start;
+            this.stop = stop;
+        }
+
+        @Override
+        public String toString() {
+            return kind == Kind.CHUNK ? start + ".." + stop : kind + " " + name;
+        }
+    }
+}
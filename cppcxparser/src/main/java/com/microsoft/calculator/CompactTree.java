@@ -0,0 +1,439 @@
+package com.microsoft.calculator;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.nio.file.StandardOpenOption;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Deque;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.misc.Utils;
+import org.antlr.v4.runtime.tree.ParseTree;
+import org.antlr.v4.runtime.tree.RuleNode;
+import org.antlr.v4.runtime.tree.TerminalNode;
+
+/**
+ * A parse tree in a few flat arrays, for tools that keep trees around or
+ * share them between processes.
+ *
+ * Nodes are numbered in preorder, the root being node 0. For every node the
+ * tree holds its kind, first child, next sibling and the span of its tokens;
+ * for every terminal its token's type, text, line, column and start index.
+ * Token texts are stored once per distinct text. The kind of a rule node is
+ * its rule index, that of a terminal the complement of its token type plus
+ * one, see {@link #getRuleIndex} and {@link #getTokenType}. Tokens are
+ * numbered in the order their terminals appear, so the tokens of a node are
+ * exactly the terminals below it; a node without terminals has an empty span
+ * whose stop is before its start.
+ *
+ * All arrays live in one big-endian buffer in the format that
+ * {@link #write} stores, so {@link #map} opens a stored tree without
+ * copying or decoding it. Files written for a different grammar are
+ * rejected. A tree is immutable and safe to share between threads.
+ */
+public class CompactTree {
+
+    private static final int MAGIC = 0x43585452; // "CXTR"
+    private static final int VERSION = 1;
+    private static final int GRAMMAR = (int) Long.parseLong(ParseCache.grammarVersion().substring(0, 8), 16);
+    private static final int HEADER_INTS = 7;
+
+    private static final int NODE_ARRAYS = 5;
+    private static final int KIND = 0;
+    private static final int FIRST_CHILD = 1;
+    private static final int NEXT_SIBLING = 2;
+    private static final int START_TOKEN = 3;
+    private static final int STOP_TOKEN = 4;
+
+    private static final int TOKEN_ARRAYS = 5;
+    private static final int TOKEN_TYPE = 0;
+    private static final int TOKEN_TEXT = 1;
+    private static final int TOKEN_LINE = 2;
+    private static final int TOKEN_COLUMN = 3;
+    private static final int TOKEN_START = 4;
+
+    private final ByteBuffer buffer;
+    private final int nodeCount;
+    private final int tokenCount;
+    private final int stringCount;
+    private final int tokensOffset;
+    private final int stringsOffset;
+    private final int bytesOffset;
+
+    private CompactTree(ByteBuffer buffer) throws IOException {
+        if (buffer.remaining() < HEADER_INTS * 4 || buffer.getInt(0) != MAGIC)
+            throw new IOException("not a compact tree");
+        if (buffer.getInt(4) != VERSION || buffer.getInt(8) != GRAMMAR)
+            throw new IOException("compact tree of another version or grammar");
+        this.buffer = buffer;
+        nodeCount = buffer.getInt(12);
+        tokenCount = buffer.getInt(16);
+        stringCount = buffer.getInt(20);
+        int byteCount = buffer.getInt(24);
+        tokensOffset = HEADER_INTS * 4 + NODE_ARRAYS * nodeCount * 4;
+        stringsOffset = tokensOffset + TOKEN_ARRAYS * tokenCount * 4;
+        bytesOffset = stringsOffset + (stringCount + 1) * 4;
+        if (nodeCount < 1 || tokenCount < 0 || stringCount < 0 || byteCount < 0
+                || (long) bytesOffset + byteCount != buffer.limit())
+            throw new IOException("damaged compact tree");
+    }
+
+    /**
+     * Converts a parse tree. The tree itself is no longer needed afterwards.
+     */
+    public static CompactTree of(ParseTree root) {
+        return new Builder().build(root);
+    }
+
+    /**
+     * Maps a file written by {@link #write}. The mapping stays valid after
+     * the file is closed, deleted or replaced.
+     */
+    public static CompactTree map(Path file) throws IOException {
+        try (FileChannel channel = FileChannel.open(file, StandardOpenOption.READ)) {
+            return new CompactTree(channel.map(FileChannel.MapMode.READ_ONLY, 0, channel.size()));
+        }
+    }
+
+    /**
+     * A tree in the stored format, e.g. read from a socket or a cache.
+     */
+    public static CompactTree wrap(ByteBuffer buffer) throws IOException {
+        return new CompactTree(buffer.slice());
+    }
+
+    public void write(OutputStream out) throws IOException {
+        ByteBuffer data = buffer.duplicate();
+        data.clear();
+        byte[] chunk = new byte[8192];
+        while (data.hasRemaining()) {
+            int n = Math.min(chunk.length, data.remaining());
+            data.get(chunk, 0, n);
+            out.write(chunk, 0, n);
+        }
+    }
+
+    /**
+     * Writes the tree to a temporary file that is then moved over the file,
+     * so that processes mapping it never see a partial tree.
+     */
+    public void write(Path file) throws IOException {
+        Path dir = file.toAbsolutePath().getParent();
+        Path temp = Files.createTempFile(dir, file.getFileName().toString(), ".tmp");
+        try {
+            try (OutputStream out = Files.newOutputStream(temp)) {
+                write(out);
+            }
+            Files.move(temp, file, StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+        } finally {
+            Files.deleteIfExists(temp);
+        }
+    }
+
+    /**
+     * Size of the stored tree, which is all the memory it takes besides
+     * this object.
+     */
+    public int getByteSize() {
+        return buffer.limit();
+    }
+
+    public int getNodeCount() {
+        return nodeCount;
+    }
+
+    public int getTokenCount() {
+        return tokenCount;
+    }
+
+    public int getKind(int node) {
+        return node(node, KIND);
+    }
+
+    public boolean isTerminal(int node) {
+        return getKind(node) < 0;
+    }
+
+    /**
+     * The rule of a rule node, or -1 for a terminal.
+     */
+    public int getRuleIndex(int node) {
+        int kind = getKind(node);
+        return kind < 0 ? -1 : kind;
+    }
+
+    /**
+     * The token type of a terminal, or {@link Token#INVALID_TYPE} for a rule
+     * node.
+     */
+    public int getTokenType(int node) {
+        int kind = getKind(node);
+        return kind < 0 ? ~kind - 1 : Token.INVALID_TYPE;
+    }
+
+    /**
+     * The first child, or -1 for a leaf.
+     */
+    public int getFirstChild(int node) {
+        return node(node, FIRST_CHILD);
+    }
+
+    /**
+     * The next child of the node's parent, or -1 for the last child.
+     */
+    public int getNextSibling(int node) {
+        return node(node, NEXT_SIBLING);
+    }
+
+    public int getChildCount(int node) {
+        int count = 0;
+        for (int child = getFirstChild(node); child >= 0; child = getNextSibling(child))
+            count++;
+        return count;
+    }
+
+    public int getStartToken(int node) {
+        return node(node, START_TOKEN);
+    }
+
+    public int getStopToken(int node) {
+        return node(node, STOP_TOKEN);
+    }
+
+    public int getTokenTypeAt(int token) {
+        return token(token, TOKEN_TYPE);
+    }
+
+    public String getTokenText(int token) {
+        int string = token(token, TOKEN_TEXT);
+        int start = buffer.getInt(stringsOffset + string * 4);
+        int end = buffer.getInt(stringsOffset + (string + 1) * 4);
+        byte[] bytes = new byte[end - start];
+        ByteBuffer data = buffer.duplicate();
+        data.position(bytesOffset + start);
+        data.get(bytes);
+        return new String(bytes, StandardCharsets.UTF_8);
+    }
+
+    public int getTokenLine(int token) {
+        return token(token, TOKEN_LINE);
+    }
+
+    public int getTokenCharPositionInLine(int token) {
+        return token(token, TOKEN_COLUMN);
+    }
+
+    /**
+     * The character index of the token in its input, or -1 for a token
+     * conjured up by error recovery.
+     */
+    public int getTokenStartIndex(int token) {
+        return token(token, TOKEN_START);
+    }
+
+    /**
+     * The texts of the node's terminals joined, as {@link ParseTree#getText}.
+     */
+    public String getText(int node) {
+        StringBuilder sb = new StringBuilder();
+        for (int token = getStartToken(node); token <= getStopToken(node); token++)
+            sb.append(getTokenText(token));
+        return sb.toString();
+    }
+
+    /**
+     * The LISP-style form of {@link org.antlr.v4.runtime.tree.Trees#toStringTree}.
+     */
+    public String toStringTree(List<String> ruleNames) {
+        StringBuilder sb = new StringBuilder();
+        appendTree(0, ruleNames, sb);
+        return sb.toString();
+    }
+
+    private void appendTree(int root, List<String> ruleNames, StringBuilder sb) {
+        // Explicit stack, expression trees can be deep. -1 closes a node.
+        Deque<Integer> stack = new ArrayDeque<>();
+        stack.push(root);
+        boolean first = true;
+        while (!stack.isEmpty()) {
+            int node = stack.pop();
+            if (node < 0) {
+                sb.append(')');
+                continue;
+            }
+            if (!first)
+                sb.append(' ');
+            first = false;
+            String text = isTerminal(node) ? getTokenText(getStartToken(node)) : ruleNames.get(getRuleIndex(node));
+            text = Utils.escapeWhitespace(text, false);
+            int child = getFirstChild(node);
+            if (child < 0) {
+                sb.append(text);
+                continue;
+            }
+            sb.append('(').append(text);
+            stack.push(-1);
+            List<Integer> children = new ArrayList<>();
+            for (; child >= 0; child = getNextSibling(child))
+                children.add(child);
+            for (int i = children.size() - 1; i >= 0; i--)
+                stack.push(children.get(i));
+        }
+    }
+
+    private int node(int node, int array) {
+        if (node < 0 || node >= nodeCount)
+            throw new IndexOutOfBoundsException("node " + node);
+        return buffer.getInt(HEADER_INTS * 4 + (array * nodeCount + node) * 4);
+    }
+
+    private int token(int token, int array) {
+        if (token < 0 || token >= tokenCount)
+            throw new IndexOutOfBoundsException("token " + token);
+        return buffer.getInt(tokensOffset + (array * tokenCount + token) * 4);
+    }
+
+    /**
+     * Flattens a parse tree in two passes, one to size the arrays and one to
+     * fill them.
+     */
+    private static class Builder {
+        private int[][] nodes;
+        private int[][] tokens;
+        private final Map<String, Integer> stringIds = new HashMap<>();
+        private final List<byte[]> strings = new ArrayList<>();
+        private int byteCount;
+        private int nodeCount;
+        private int tokenCount;
+
+        CompactTree build(ParseTree root) {
+            int[] sizes = count(root);
+            nodes = new int[NODE_ARRAYS][sizes[0]];
+            tokens = new int[TOKEN_ARRAYS][sizes[1]];
+            fill(root);
+
+            int size = HEADER_INTS * 4 + NODE_ARRAYS * nodeCount * 4 + TOKEN_ARRAYS * tokenCount * 4
+                    + (strings.size() + 1) * 4 + byteCount;
+            ByteBuffer buffer = ByteBuffer.allocate(size);
+            buffer.putInt(MAGIC).putInt(VERSION).putInt(GRAMMAR).putInt(nodeCount).putInt(tokenCount)
+                    .putInt(strings.size()).putInt(byteCount);
+            for (int[] array : nodes)
+                putInts(buffer, array);
+            for (int[] array : tokens)
+                putInts(buffer, array);
+            int offset = 0;
+            for (byte[] string : strings) {
+                buffer.putInt(offset);
+                offset += string.length;
+            }
+            buffer.putInt(offset);
+            for (byte[] string : strings)
+                buffer.put(string);
+            buffer.flip();
+            try {
+                return new CompactTree(buffer);
+            } catch (IOException e) {
+                throw new IllegalStateException(e);
+            }
+        }
+
+        private static void putInts(ByteBuffer buffer, int[] array) {
+            buffer.asIntBuffer().put(array);
+            buffer.position(buffer.position() + array.length * 4);
+        }
+
+        private static int[] count(ParseTree root) {
+            int[] sizes = new int[2];
+            Deque<ParseTree> stack = new ArrayDeque<>();
+            stack.push(root);
+            while (!stack.isEmpty()) {
+                ParseTree tree = stack.pop();
+                sizes[0]++;
+                if (tree instanceof TerminalNode)
+                    sizes[1]++;
+                for (int i = 0; i < tree.getChildCount(); i++)
+                    stack.push(tree.getChild(i));
+            }
+            return sizes;
+        }
+
+        /**
+         * Numbers the nodes in preorder. A node's sibling link and token
+         * stop are set once its last descendant has been numbered.
+         */
+        private void fill(ParseTree root) {
+            Deque<Frame> stack = new ArrayDeque<>();
+            stack.push(new Frame(root, add(root)));
+            while (!stack.isEmpty()) {
+                Frame frame = stack.peek();
+                if (frame.next == frame.tree.getChildCount()) {
+                    stack.pop();
+                    nodes[NEXT_SIBLING][frame.node] = -1;
+                    nodes[STOP_TOKEN][frame.node] = tokenCount - 1;
+                    continue;
+                }
+                ParseTree child = frame.tree.getChild(frame.next++);
+                int node = add(child);
+                if (frame.lastChild < 0)
+                    nodes[FIRST_CHILD][frame.node] = node;
+                else
+                    nodes[NEXT_SIBLING][frame.lastChild] = node;
+                frame.lastChild = node;
+                stack.push(new Frame(child, node));
+            }
+        }
+
+        private int add(ParseTree tree) {
+            int node = nodeCount++;
+            nodes[FIRST_CHILD][node] = -1;
+            nodes[START_TOKEN][node] = tokenCount;
+            if (tree instanceof RuleNode) {
+                nodes[KIND][node] = ((RuleNode) tree).getRuleContext().getRuleIndex();
+            } else {
+                Token token = ((TerminalNode) tree).getSymbol();
+                nodes[KIND][node] = ~(token.getType() + 1);
+                int t = tokenCount++;
+                tokens[TOKEN_TYPE][t] = token.getType();
+                tokens[TOKEN_TEXT][t] = string(token.getText() == null ? "" : token.getText());
+                tokens[TOKEN_LINE][t] = token.getLine();
+                tokens[TOKEN_COLUMN][t] = token.getCharPositionInLine();
+                tokens[TOKEN_START][t] = token.getStartIndex();
+            }
+            return node;
+        }
+
+        private int string(String text) {
+            Integer id = stringIds.get(text);
+            if (id == null) {
+                id = strings.size();
+                byte[] bytes = text.getBytes(StandardCharsets.UTF_8);
+                strings.add(bytes);
+                byteCount += bytes.length;
+                stringIds.put(text, id);
+            }
+            return id;
+        }
+    }
+
+    private static class Frame {
+        final ParseTree tree;
+        final int node;
+        int next;
+        int lastChild = -1;
+
+        Frame(ParseTree tree, int node) {
+            this.tree = tree;
+            this.node = node;
+        }
+    }
+}
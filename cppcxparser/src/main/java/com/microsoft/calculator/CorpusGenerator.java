@@ -0,0 +1,314 @@
+package com.microsoft.calculator;
+
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Locale;
+import java.util.Random;
+
+/**
+ * Generates C++/CX source trees of a given size for benchmarks and soak
+ * tests.
+ *
+ * Every file is shaped like the Calculator sources: includes and
+ * {@code #pragma once}, nested namespaces with enum classes, bindable ref
+ * classes implementing {@code INotifyPropertyChanged} with
+ * {@code PROPERTY_R} and the other property macros, explicit
+ * properties, methods with lambdas, {@code ref new} and loops, and free
+ * functions whose arithmetic expressions nest to the configured depth. The
+ * macros are those of {@link MacroTable#calculatorDefaults()}.
+ *
+ * A file depends only on the seed and its index, so a tree can be written
+ * in any order or in parts and is the same on every machine. Files are
+ * written one at a time, so the tree may be far larger than the heap.
+ *
+ * Usage: CorpusGenerator [--seed n] [--file-size bytes] [--depth n] size dir
+ *
+ * Sizes take a k, m or g suffix, as in {@code CorpusGenerator 2g /tmp/corpus}.
+ */
+public class CorpusGenerator {
+
+    public static final int DEFAULT_FILE_BYTES = 64 * 1024;
+    public static final int DEFAULT_DEPTH = 8;
+
+    /** Files per directory of a generated tree. */
+    static final int FILES_PER_DIRECTORY = 100;
+
+    private static final String[] TYPES = { "int", "double", "bool", "Platform::String ^",
+            "Windows::Foundation::Collections::IVector<Platform::String ^> ^" };
+    private static final String[] PROPERTY_MACROS = { "PROPERTY_R", "PROPERTY_RW", "OBSERVABLE_PROPERTY_R",
+            "OBSERVABLE_PROPERTY_RW" };
+    private static final String[] OPERATORS = { "+", "-", "*", "/", "%", "<<", ">>", "&", "|", "^" };
+
+    private final long seed;
+    private int fileBytes = DEFAULT_FILE_BYTES;
+    private int depth = DEFAULT_DEPTH;
+
+    public CorpusGenerator(long seed) {
+        this.seed = seed;
+    }
+
+    /**
+     * The approximate size of each file.
+     */
+    public void setFileBytes(int fileBytes) {
+        if (fileBytes < 1)
+            throw new IllegalArgumentException("fileBytes must be positive: " + fileBytes);
+        this.fileBytes = fileBytes;
+    }
+
+    /**
+     * The nesting depth of the deepest expressions.
+     */
+    public void setDepth(int depth) {
+        if (depth < 1)
+            throw new IllegalArgumentException("depth must be positive: " + depth);
+        this.depth = depth;
+    }
+
+    /**
+     * Writes files until they hold at least the bytes, in directories of
+     * {@link #FILES_PER_DIRECTORY} files below the given one.
+     *
+     * @return the files written, in order
+     */
+    public List<Path> write(Path directory, long bytes) throws IOException {
+        List<Path> files = new ArrayList<>();
+        long written = 0;
+        for (int i = 0; written < bytes; i++) {
+            Path dir = directory.resolve(String.format(Locale.ROOT, "d%04d", i / FILES_PER_DIRECTORY));
+            if (i % FILES_PER_DIRECTORY == 0)
+                Files.createDirectories(dir);
+            Path file = dir.resolve(String.format(Locale.ROOT, "Generated%06d.cpp", i));
+            byte[] content = generate(i).getBytes(StandardCharsets.UTF_8);
+            Files.write(file, content);
+            files.add(file);
+            written += content.length;
+        }
+        return files;
+    }
+
+    /**
+     * The source of the file with the index.
+     */
+    public String generate(int index) {
+        return new SourceWriter(new Random(seed * 0x9E3779B97F4A7C15L + index), index).write();
+    }
+
+    public static void main(String[] args) throws IOException {
+        long seed = 1;
+        int fileBytes = DEFAULT_FILE_BYTES;
+        int depth = DEFAULT_DEPTH;
+        List<String> positional = new ArrayList<>();
+        for (int i = 0; i < args.length; i++) {
+            if (args[i].equals("--seed") && i + 1 < args.length)
+                seed = Long.parseLong(args[++i]);
+            else if (args[i].equals("--file-size") && i + 1 < args.length)
+                fileBytes = (int) parseSize(args[++i]);
+            else if (args[i].equals("--depth") && i + 1 < args.length)
+                depth = Integer.parseInt(args[++i]);
+            else
+                positional.add(args[i]);
+        }
+        if (positional.size() != 2) {
+            System.err.println("usage: CorpusGenerator [--seed n] [--file-size bytes] [--depth n] size dir");
+            System.exit(2);
+        }
+        CorpusGenerator generator = new CorpusGenerator(seed);
+        generator.setFileBytes(fileBytes);
+        generator.setDepth(depth);
+        List<Path> files = generator.write(Paths.get(positional.get(1)), parseSize(positional.get(0)));
+        System.out.println(files.size() + " files written to " + positional.get(1));
+    }
+
+    /**
+     * A byte count with an optional k, m or g suffix.
+     */
+    public static long parseSize(String size) {
+        String s = size.trim().toLowerCase(Locale.ROOT);
+        long unit = 1;
+        if (s.endsWith("k"))
+            unit = 1L << 10;
+        else if (s.endsWith("m"))
+            unit = 1L << 20;
+        else if (s.endsWith("g"))
+            unit = 1L << 30;
+        if (unit > 1)
+            s = s.substring(0, s.length() - 1);
+        return Long.parseLong(s) * unit;
+    }
+
+    /**
+     * Writes the source of one file.
+     */
+    private class SourceWriter {
+        private final Random random;
+        private final int index;
+        private final StringBuilder sb = new StringBuilder(fileBytes + 4096);
+        private int indent;
+        private int classes;
+        private int enums;
+        private int functions;
+
+        SourceWriter(Random random, int index) {
+            this.random = random;
+            this.index = index;
+        }
+
+        String write() {
+            line("// Generated by CorpusGenerator, file " + index + ".");
+            line("");
+            line("#pragma once");
+            line("");
+            line("#include \"pch.h\"");
+            line("#include \"Common/Utils.h\"");
+            line("");
+            line("using namespace Platform;");
+            line("using namespace Windows::UI::Xaml::Data;");
+            line("");
+            line("namespace CalculatorApp");
+            open();
+            line("namespace Generated" + index);
+            open();
+            while (sb.length() < fileBytes) {
+                int kind = random.nextInt(10);
+                if (kind < 2)
+                    enumClass();
+                else if (kind < 7)
+                    refClass();
+                else if (kind < 9)
+                    freeFunction();
+                else
+                    nestedNamespace();
+            }
+            close("");
+            close("");
+            return sb.toString();
+        }
+
+        private void nestedNamespace() {
+            line("namespace Detail" + classes);
+            open();
+            enumClass();
+            freeFunction();
+            close("");
+        }
+
+        private void enumClass() {
+            int n = enums++;
+            line((random.nextBoolean() ? "public " : "") + "enum class Mode" + n
+                    + (random.nextBoolean() ? " : int" : ""));
+            open();
+            int count = 2 + random.nextInt(20);
+            for (int i = 0; i < count; i++)
+                line("Value" + i + " = " + (random.nextInt(4) == 0 ? 1 << i % 16 : i) + (i + 1 < count ? "," : ""));
+            close(";");
+        }
+
+        private void refClass() {
+            int n = classes++;
+            String name = "Item" + n;
+            line("[Windows::UI::Xaml::Data::Bindable] public ref class " + name
+                    + " sealed : public Windows::UI::Xaml::Data::INotifyPropertyChanged");
+            open();
+            line("public:");
+            line(name + "()");
+            open();
+            line("m_count = " + expression(2, "0", "1") + ";");
+            close("");
+            line("");
+            int macros = 1 + random.nextInt(4);
+            for (int i = 0; i < macros; i++)
+                line(PROPERTY_MACROS[random.nextInt(PROPERTY_MACROS.length)] + "(" + type() + ", Field" + i + ");");
+            line("");
+            line("property int Count");
+            open();
+            line("int get() { return m_count; }");
+            line("void set(int value) { m_count = value; }");
+            close("");
+            line("");
+            int methods = 1 + random.nextInt(3);
+            for (int i = 0; i < methods; i++)
+                method(i);
+            line("");
+            line("private:");
+            line("int m_count;");
+            close(";");
+        }
+
+        private void method(int n) {
+            line("int Compute" + n + "(int a, int b)");
+            open();
+            line("auto scale = [this, a](int x) -> int { return " + expression(3, "x", "a", "m_count") + "; };");
+            line("auto copy = ref new Platform::Collections::Vector<int>();");
+            line("for (int i = 0; i < a; ++i)");
+            open();
+            line("copy->Append(scale(" + expression(2, "i", "b") + "));");
+            close("");
+            line("if (" + expression(2, "a", "b") + " > " + expression(2, "b", "1") + ")");
+            open();
+            line("return " + expression(depth, "a", "b", "m_count") + ";");
+            close("");
+            line("return static_cast<int>(copy->Size);");
+            close("");
+        }
+
+        private void freeFunction() {
+            int n = functions++;
+            line("inline int Helper" + n + "(int a, int b, int c)");
+            open();
+            line("int total = " + expression(depth, "a", "b", "c") + ";");
+            line("while (total > " + expression(2, "c", "1") + ")");
+            open();
+            line("total = " + expression(depth / 2 + 1, "total", "a") + ";");
+            line("if (total == 0) { break; }");
+            close("");
+            line("return total != 0 ? " + expression(3, "total", "b") + " : c;");
+            close("");
+        }
+
+        /**
+         * A parenthesized expression over the variables and literals that
+         * nests to the depth along one operand and stays shallow in the
+         * others, so that its length grows linearly with the depth.
+         */
+        private String expression(int depth, String... variables) {
+            if (depth <= 1) {
+                if (random.nextInt(3) == 0)
+                    return Integer.toString(1 + random.nextInt(100));
+                return variables[random.nextInt(variables.length)];
+            }
+            String deep = expression(depth - 1, variables);
+            String shallow = expression(Math.min(2, depth - 1), variables);
+            if (random.nextInt(8) == 0)
+                return "(" + deep + " > 0 ? " + shallow + " : " + expression(1, variables) + ")";
+            String operator = OPERATORS[random.nextInt(OPERATORS.length)];
+            return random.nextBoolean() ? "(" + deep + " " + operator + " " + shallow + ")"
+                    : "(" + shallow + " " + operator + " " + deep + ")";
+        }
+
+        private String type() {
+            return TYPES[random.nextInt(TYPES.length)];
+        }
+
+        private void open() {
+            line("{");
+            indent++;
+        }
+
+        private void close(String suffix) {
+            indent--;
+            line("}" + suffix);
+        }
+
+        private void line(String text) {
+            for (int i = 0; i < indent; i++)
+                sb.append("    ");
+            sb.append(text).append('\n');
+        }
+    }
+}
@@ -1,2320 +1,161 @@
 package com.microsoft.calculator;
 
-import com.microsoft.CPPCXParser.*;
-import com.microsoft.CPPCXParserListener;
-
-import org.antlr.v4.runtime.ParserRuleContext;
-import org.antlr.v4.runtime.tree.ErrorNode;
-import org.antlr.v4.runtime.tree.ParseTreeListener;
-import org.antlr.v4.runtime.tree.RuleNode;
-import org.antlr.v4.runtime.tree.TerminalNode;
-
-public class CxListener implements CPPCXParserListener {
-
-    @Override
-    public void visitTerminal(TerminalNode node) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void visitErrorNode(ErrorNode node) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterEveryRule(ParserRuleContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitEveryRule(ParserRuleContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTranslationUnit(TranslationUnitContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTranslationUnit(TranslationUnitContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterPrimaryExpression(PrimaryExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitPrimaryExpression(PrimaryExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterIdExpression(IdExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitIdExpression(IdExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterUnqualifiedId(UnqualifiedIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitUnqualifiedId(UnqualifiedIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterQualifiedId(QualifiedIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitQualifiedId(QualifiedIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNestedNameSpecifier(NestedNameSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNestedNameSpecifier(NestedNameSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterLambdaExpression(LambdaExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitLambdaExpression(LambdaExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterLambdaIntroducer(LambdaIntroducerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitLambdaIntroducer(LambdaIntroducerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterLambdaCapture(LambdaCaptureContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitLambdaCapture(LambdaCaptureContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterCaptureDefault(CaptureDefaultContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitCaptureDefault(CaptureDefaultContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterCaptureList(CaptureListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitCaptureList(CaptureListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterCapture(CaptureContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitCapture(CaptureContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterSimpleCapture(SimpleCaptureContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitSimpleCapture(SimpleCaptureContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterInitcapture(InitcaptureContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitInitcapture(InitcaptureContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterLambdaDeclarator(LambdaDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitLambdaDeclarator(LambdaDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterPostfixExpression(PostfixExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitPostfixExpression(PostfixExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTypeIdOfTheTypeId(TypeIdOfTheTypeIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTypeIdOfTheTypeId(TypeIdOfTheTypeIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterExpressionList(ExpressionListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitExpressionList(ExpressionListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterPseudoDestructorName(PseudoDestructorNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitPseudoDestructorName(PseudoDestructorNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterUnaryExpression(UnaryExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitUnaryExpression(UnaryExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterUnaryOperator(UnaryOperatorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitUnaryOperator(UnaryOperatorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNewExpression(NewExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNewExpression(NewExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNewPlacement(NewPlacementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNewPlacement(NewPlacementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNewTypeId(NewTypeIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNewTypeId(NewTypeIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNewDeclarator(NewDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNewDeclarator(NewDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNoPointerNewDeclarator(NoPointerNewDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNoPointerNewDeclarator(NoPointerNewDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNewInitializer(NewInitializerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNewInitializer(NewInitializerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterDeleteExpression(DeleteExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitDeleteExpression(DeleteExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNoExceptExpression(NoExceptExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNoExceptExpression(NoExceptExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterCastExpression(CastExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitCastExpression(CastExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterPointerMemberExpression(PointerMemberExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitPointerMemberExpression(PointerMemberExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterMultiplicativeExpression(MultiplicativeExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitMultiplicativeExpression(MultiplicativeExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAdditiveExpression(AdditiveExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAdditiveExpression(AdditiveExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterShiftExpression(ShiftExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitShiftExpression(ShiftExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterShiftOperator(ShiftOperatorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitShiftOperator(ShiftOperatorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterRelationalExpression(RelationalExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitRelationalExpression(RelationalExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterEqualityExpression(EqualityExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitEqualityExpression(EqualityExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAndExpression(AndExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAndExpression(AndExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterExclusiveOrExpression(ExclusiveOrExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitExclusiveOrExpression(ExclusiveOrExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterInclusiveOrExpression(InclusiveOrExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitInclusiveOrExpression(InclusiveOrExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterLogicalAndExpression(LogicalAndExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitLogicalAndExpression(LogicalAndExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterLogicalOrExpression(LogicalOrExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitLogicalOrExpression(LogicalOrExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterConditionalExpression(ConditionalExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitConditionalExpression(ConditionalExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAssignmentExpression(AssignmentExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAssignmentExpression(AssignmentExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAssignmentOperator(AssignmentOperatorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAssignmentOperator(AssignmentOperatorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterExpression(ExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitExpression(ExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterConstantExpression(ConstantExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitConstantExpression(ConstantExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterStatement(StatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitStatement(StatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterLabeledStatement(LabeledStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitLabeledStatement(LabeledStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterExpressionStatement(ExpressionStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitExpressionStatement(ExpressionStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterCompoundStatement(CompoundStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitCompoundStatement(CompoundStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterStatementSeq(StatementSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitStatementSeq(StatementSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterSelectionStatement(SelectionStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitSelectionStatement(SelectionStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterCondition(ConditionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitCondition(ConditionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterIterationStatement(IterationStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitIterationStatement(IterationStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterForInitStatement(ForInitStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitForInitStatement(ForInitStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterForRangeDeclaration(ForRangeDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitForRangeDeclaration(ForRangeDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterForRangeInitializer(ForRangeInitializerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitForRangeInitializer(ForRangeInitializerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterJumpStatement(JumpStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitJumpStatement(JumpStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterDeclarationStatement(DeclarationStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitDeclarationStatement(DeclarationStatementContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterDeclarationseq(DeclarationseqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitDeclarationseq(DeclarationseqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterDeclaration(DeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitDeclaration(DeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterBlockDeclaration(BlockDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitBlockDeclaration(BlockDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAliasDeclaration(AliasDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAliasDeclaration(AliasDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterSimpleDeclaration(SimpleDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitSimpleDeclaration(SimpleDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterStaticAssertDeclaration(StaticAssertDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitStaticAssertDeclaration(StaticAssertDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterEmptyDeclaration(EmptyDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitEmptyDeclaration(EmptyDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAttributeDeclaration(AttributeDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAttributeDeclaration(AttributeDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterDeclSpecifier(DeclSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitDeclSpecifier(DeclSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterDeclSpecifierSeq(DeclSpecifierSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitDeclSpecifierSeq(DeclSpecifierSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterStorageClassSpecifier(StorageClassSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitStorageClassSpecifier(StorageClassSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterFunctionSpecifier(FunctionSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitFunctionSpecifier(FunctionSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTypedefName(TypedefNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTypedefName(TypedefNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTypeSpecifier(TypeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTypeSpecifier(TypeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTrailingTypeSpecifier(TrailingTypeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTrailingTypeSpecifier(TrailingTypeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTypeSpecifierSeq(TypeSpecifierSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTypeSpecifierSeq(TypeSpecifierSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTrailingTypeSpecifierSeq(TrailingTypeSpecifierSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTrailingTypeSpecifierSeq(TrailingTypeSpecifierSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterSimpleTypeSpecifier(SimpleTypeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitSimpleTypeSpecifier(SimpleTypeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTheTypeName(TheTypeNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTheTypeName(TheTypeNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterDecltypeSpecifier(DecltypeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitDecltypeSpecifier(DecltypeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterElaboratedTypeSpecifier(ElaboratedTypeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitElaboratedTypeSpecifier(ElaboratedTypeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterEnumName(EnumNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitEnumName(EnumNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterEnumSpecifier(EnumSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitEnumSpecifier(EnumSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterEnumHead(EnumHeadContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitEnumHead(EnumHeadContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterOpaqueEnumDeclaration(OpaqueEnumDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitOpaqueEnumDeclaration(OpaqueEnumDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterEnumkey(EnumkeyContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitEnumkey(EnumkeyContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterEnumbase(EnumbaseContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitEnumbase(EnumbaseContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterEnumeratorList(EnumeratorListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitEnumeratorList(EnumeratorListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterEnumeratorDefinition(EnumeratorDefinitionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitEnumeratorDefinition(EnumeratorDefinitionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterEnumerator(EnumeratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitEnumerator(EnumeratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNamespaceName(NamespaceNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNamespaceName(NamespaceNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterQualifiednamespacespecifier(QualifiednamespacespecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitQualifiednamespacespecifier(QualifiednamespacespecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNamespaceDefinition(NamespaceDefinitionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNamespaceDefinition(NamespaceDefinitionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNamespaceAliasDefinition(NamespaceAliasDefinitionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNamespaceAliasDefinition(NamespaceAliasDefinitionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterUsingDeclaration(UsingDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitUsingDeclaration(UsingDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterUsingDirective(UsingDirectiveContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitUsingDirective(UsingDirectiveContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAsmDefinition(AsmDefinitionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAsmDefinition(AsmDefinitionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterLinkageSpecification(LinkageSpecificationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitLinkageSpecification(LinkageSpecificationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAttributeSpecifierSeq(AttributeSpecifierSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAttributeSpecifierSeq(AttributeSpecifierSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAttributeSpecifier(AttributeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAttributeSpecifier(AttributeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAlignmentspecifier(AlignmentspecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAlignmentspecifier(AlignmentspecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAttributeList(AttributeListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAttributeList(AttributeListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAttribute(AttributeContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAttribute(AttributeContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAttributeNamespace(AttributeNamespaceContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAttributeNamespace(AttributeNamespaceContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAttributeArgumentClause(AttributeArgumentClauseContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAttributeArgumentClause(AttributeArgumentClauseContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterBalancedTokenSeq(BalancedTokenSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitBalancedTokenSeq(BalancedTokenSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterBalancedtoken(BalancedtokenContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitBalancedtoken(BalancedtokenContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterInitDeclaratorList(InitDeclaratorListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitInitDeclaratorList(InitDeclaratorListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterInitDeclarator(InitDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitInitDeclarator(InitDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterDeclarator(DeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitDeclarator(DeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterPointerDeclarator(PointerDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitPointerDeclarator(PointerDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNoPointerDeclarator(NoPointerDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNoPointerDeclarator(NoPointerDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterParametersAndQualifiers(ParametersAndQualifiersContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitParametersAndQualifiers(ParametersAndQualifiersContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTrailingReturnType(TrailingReturnTypeContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTrailingReturnType(TrailingReturnTypeContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterPointerOperator(PointerOperatorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitPointerOperator(PointerOperatorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterCvqualifierseq(CvqualifierseqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitCvqualifierseq(CvqualifierseqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterCvQualifier(CvQualifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitCvQualifier(CvQualifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterRefqualifier(RefqualifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitRefqualifier(RefqualifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterDeclaratorid(DeclaratoridContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitDeclaratorid(DeclaratoridContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTheTypeId(TheTypeIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTheTypeId(TheTypeIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAbstractDeclarator(AbstractDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAbstractDeclarator(AbstractDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterPointerAbstractDeclarator(PointerAbstractDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitPointerAbstractDeclarator(PointerAbstractDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNoPointerAbstractDeclarator(NoPointerAbstractDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNoPointerAbstractDeclarator(NoPointerAbstractDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAbstractPackDeclarator(AbstractPackDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAbstractPackDeclarator(AbstractPackDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterNoPointerAbstractPackDeclarator(NoPointerAbstractPackDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitNoPointerAbstractPackDeclarator(NoPointerAbstractPackDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterParameterDeclarationClause(ParameterDeclarationClauseContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitParameterDeclarationClause(ParameterDeclarationClauseContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterParameterDeclarationList(ParameterDeclarationListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitParameterDeclarationList(ParameterDeclarationListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterParameterDeclaration(ParameterDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitParameterDeclaration(ParameterDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterFunctionDefinition(FunctionDefinitionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitFunctionDefinition(FunctionDefinitionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterPropertyBody(PropertyBodyContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitPropertyBody(PropertyBodyContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterPropertyDefinition(PropertyDefinitionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitPropertyDefinition(PropertyDefinitionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterFunctionBody(FunctionBodyContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitFunctionBody(FunctionBodyContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterInitializer(InitializerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitInitializer(InitializerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterBraceOrEqualInitializer(BraceOrEqualInitializerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitBraceOrEqualInitializer(BraceOrEqualInitializerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterInitializerClause(InitializerClauseContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitInitializerClause(InitializerClauseContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterInitializerList(InitializerListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitInitializerList(InitializerListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterBracedInitList(BracedInitListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitBracedInitList(BracedInitListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterClassName(ClassNameContext ctx) {
-        // TODO Auto-generated method stub
-    }
-
-    @Override
-    public void exitClassName(ClassNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterClassSpecifier(ClassSpecifierContext ctx) {
-        String out;
-        if (ctx.cxAttribute() == null)
-            out = ctx.classHead().classHeadName().getText();
-        else
-            out = ctx.cxAttribute().getText() + " " + ctx.classHead().classHeadName().getText();
-        System.out.println(out);
-    }
-
-    @Override
-    public void exitClassSpecifier(ClassSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterClassHead(ClassHeadContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitClassHead(ClassHeadContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterClassHeadName(ClassHeadNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitClassHeadName(ClassHeadNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterClassVirtSpecifier(ClassVirtSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitClassVirtSpecifier(ClassVirtSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterCxAttribute(CxAttributeContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitCxAttribute(CxAttributeContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterClassKey(ClassKeyContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitClassKey(ClassKeyContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterMemberSpecification(MemberSpecificationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitMemberSpecification(MemberSpecificationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterMemberdeclaration(MemberdeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitMemberdeclaration(MemberdeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterMemberDeclaratorList(MemberDeclaratorListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitMemberDeclaratorList(MemberDeclaratorListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterMemberDeclarator(MemberDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitMemberDeclarator(MemberDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterVirtualSpecifierSeq(VirtualSpecifierSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitVirtualSpecifierSeq(VirtualSpecifierSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterVirtualSpecifier(VirtualSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitVirtualSpecifier(VirtualSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterPureSpecifier(PureSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitPureSpecifier(PureSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterBaseClause(BaseClauseContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitBaseClause(BaseClauseContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterBaseSpecifierList(BaseSpecifierListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitBaseSpecifierList(BaseSpecifierListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterBaseSpecifier(BaseSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitBaseSpecifier(BaseSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterClassOrDeclType(ClassOrDeclTypeContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitClassOrDeclType(ClassOrDeclTypeContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterBaseTypeSpecifier(BaseTypeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitBaseTypeSpecifier(BaseTypeSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterAccessSpecifier(AccessSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitAccessSpecifier(AccessSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterConversionFunctionId(ConversionFunctionIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitConversionFunctionId(ConversionFunctionIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterConversionTypeId(ConversionTypeIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitConversionTypeId(ConversionTypeIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterConversionDeclarator(ConversionDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitConversionDeclarator(ConversionDeclaratorContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterConstructorInitializer(ConstructorInitializerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitConstructorInitializer(ConstructorInitializerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterMemInitializerList(MemInitializerListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitMemInitializerList(MemInitializerListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterMemInitializer(MemInitializerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitMemInitializer(MemInitializerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterMeminitializerid(MeminitializeridContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitMeminitializerid(MeminitializeridContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterOperatorFunctionId(OperatorFunctionIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitOperatorFunctionId(OperatorFunctionIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterLiteralOperatorId(LiteralOperatorIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitLiteralOperatorId(LiteralOperatorIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTemplateDeclaration(TemplateDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTemplateDeclaration(TemplateDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTemplateparameterList(TemplateparameterListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTemplateparameterList(TemplateparameterListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTemplateParameter(TemplateParameterContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTemplateParameter(TemplateParameterContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTypeParameter(TypeParameterContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTypeParameter(TypeParameterContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterSimpleTemplateId(SimpleTemplateIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitSimpleTemplateId(SimpleTemplateIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTemplateId(TemplateIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTemplateId(TemplateIdContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTemplateName(TemplateNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTemplateName(TemplateNameContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTemplateArgumentList(TemplateArgumentListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTemplateArgumentList(TemplateArgumentListContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTemplateArgument(TemplateArgumentContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTemplateArgument(TemplateArgumentContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTypeNameSpecifier(TypeNameSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTypeNameSpecifier(TypeNameSpecifierContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterExplicitInstantiation(ExplicitInstantiationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitExplicitInstantiation(ExplicitInstantiationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterExplicitSpecialization(ExplicitSpecializationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitExplicitSpecialization(ExplicitSpecializationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterTryBlock(TryBlockContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitTryBlock(TryBlockContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterFunctionTryBlock(FunctionTryBlockContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitFunctionTryBlock(FunctionTryBlockContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterHandlerSeq(HandlerSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitHandlerSeq(HandlerSeqContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterHandler(HandlerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitHandler(HandlerContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterExceptionDeclaration(ExceptionDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitExceptionDeclaration(ExceptionDeclarationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterThrowExpression(ThrowExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void exitThrowExpression(ThrowExpressionContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
-
-    @Override
-    public void enterExceptionSpecification(ExceptionSpecificationContext ctx) {
-        // TODO Auto-generated method stub
-
-    }
+import java.util.ArrayDeque;
+import java.util.Deque;
+import java.util.Iterator;
 
-    @Override
-    public void exitExceptionSpecification(ExceptionSpecificationContext ctx) {
-        // TODO Auto-generated method stub
+import com.microsoft.CPPCXParser.*;
+import com.microsoft.CPPCXParserBaseListener;
 
-    }
+/**
+ * Extracts an {@link ApiModel} from a parse tree.
+ *
+ * Only the rules that make up the API surface are overridden: namespaces,
+ * class specifiers with their C++/CX attributes and base clauses, property
+ * definitions and enum specifiers. The listener can also be fed by a
+ * {@link StreamingParser}, which reports namespaces as events instead of
+ * tree nodes. Its declarations are visited with an {@link ApiModelBuilder}.
+ */
+public class CxListener extends CPPCXParserBaseListener implements StreamingParser.Handler {
 
-    @Override
-    public void enterDynamicExceptionSpecification(DynamicExceptionSpecificationContext ctx) {
-        // TODO Auto-generated method stub
+    private final ApiModel model = new ApiModel();
+    private final Deque<String> scopes = new ArrayDeque<>();
+    private final Deque<ApiModel.ClassInfo> classes = new ArrayDeque<>();
 
+    public ApiModel getModel() {
+        return model;
     }
 
     @Override
-    public void exitDynamicExceptionSpecification(DynamicExceptionSpecificationContext ctx) {
-        // TODO Auto-generated method stub
-
+    public void enterNamespace(String name) {
+        scopes.push(name);
     }
 
     @Override
-    public void enterTypeIdList(TypeIdListContext ctx) {
-        // TODO Auto-generated method stub
-
+    public void declaration(DeclarationContext declaration) {
+        new ApiModelBuilder(this).visit(declaration);
     }
 
     @Override
-    public void exitTypeIdList(TypeIdListContext ctx) {
-        // TODO Auto-generated method stub
-
+    public void exitNamespace(String name) {
+        scopes.pop();
     }
 
     @Override
-    public void enterNoeExceptSpecification(NoeExceptSpecificationContext ctx) {
-        // TODO Auto-generated method stub
-
+    public void enterNamespaceDefinition(NamespaceDefinitionContext ctx) {
+        QualifiednamespacespecifierContext name = ctx.qualifiednamespacespecifier();
+        enterNamespace(name == null ? "" : name.getText());
     }
 
     @Override
-    public void exitNoeExceptSpecification(NoeExceptSpecificationContext ctx) {
-        // TODO Auto-generated method stub
-
+    public void exitNamespaceDefinition(NamespaceDefinitionContext ctx) {
+        scopes.pop();
     }
 
     @Override
-    public void enterTheOperator(TheOperatorContext ctx) {
-        // TODO Auto-generated method stub
-
+    public void enterClassSpecifier(ClassSpecifierContext ctx) {
+        ClassHeadContext head = ctx.classHead();
+        String name = head.classHeadName() == null ? "" : head.classHeadName().getText();
+        String key;
+        boolean ref = false;
+        if (head.Union() != null) {
+            key = "union";
+        } else {
+            ref = head.classKey().Ref() != null;
+            key = (ref ? "ref " : "") + (head.classKey().Class() != null ? "class" : "struct");
+        }
+        boolean sealed = head.classVirtSpecifier() != null;
+        String access = ctx.accessSpecifier() == null ? null : ctx.accessSpecifier().getText();
+
+        ApiModel.ClassInfo cls = new ApiModel.ClassInfo(currentScope(), name, key, ref, sealed, access,
+                ctx.getStart().getLine());
+        if (ctx.cxAttribute() != null)
+            cls.getAttributes().add(ctx.cxAttribute().classHeadName().getText());
+        if (head.baseClause() != null) {
+            for (BaseSpecifierContext base : head.baseClause().baseSpecifierList().baseSpecifier())
+                cls.getBases().add(base.baseTypeSpecifier().getText());
+        }
+
+        model.addClass(cls);
+        classes.push(cls);
+        scopes.push(name);
     }
 
     @Override
-    public void exitTheOperator(TheOperatorContext ctx) {
-        // TODO Auto-generated method stub
-
+    public void exitClassSpecifier(ClassSpecifierContext ctx) {
+        classes.pop();
+        scopes.pop();
     }
 
     @Override
-    public void enterLiteral(LiteralContext ctx) {
-        // TODO Auto-generated method stub
-
+    public void enterPropertyDefinition(PropertyDefinitionContext ctx) {
+        if (classes.isEmpty())
+            return;
+        StringBuilder type = new StringBuilder(ctx.declSpecifier().getText());
+        String name;
+        MemberDeclaratorContext member = ctx.memberDeclarator();
+        if (member.declarator() == null) {
+            name = member.Identifier() == null ? "" : member.Identifier().getText();
+        } else {
+            DeclaratorContext declarator = member.declarator();
+            NoPointerDeclaratorContext noPointer;
+            if (declarator.pointerDeclarator() != null) {
+                for (PointerOperatorContext pointer : declarator.pointerDeclarator().pointerOperator())
+                    type.append(pointer.getText());
+                noPointer = declarator.pointerDeclarator().noPointerDeclarator();
+            } else {
+                noPointer = declarator.noPointerDeclarator();
+            }
+            name = declaratorName(noPointer);
+        }
+        classes.peek().getProperties().add(new ApiModel.PropertyInfo(name, type.toString(), ctx.getStart().getLine()));
     }
 
     @Override
-    public void exitLiteral(LiteralContext ctx) {
-        // TODO Auto-generated method stub
-
+    public void enterEnumSpecifier(EnumSpecifierContext ctx) {
+        EnumHeadContext head = ctx.enumHead();
+        EnumkeyContext key = head.enumkey();
+        String name = head.Identifier() == null ? "" : head.Identifier().getText();
+        boolean scoped = key.Class() != null || key.Struct() != null;
+        String access = key.accessSpecifier() == null ? null : key.accessSpecifier().getText();
+        String underlyingType = head.enumbase() == null ? null : head.enumbase().typeSpecifierSeq().getText();
+
+        ApiModel.EnumInfo e = new ApiModel.EnumInfo(currentScope(), name, scoped, access, underlyingType,
+                ctx.getStart().getLine());
+        if (ctx.enumeratorList() != null) {
+            for (EnumeratorDefinitionContext enumerator : ctx.enumeratorList().enumeratorDefinition())
+                e.getEnumerators().add(enumerator.enumerator().getText());
+        }
+        model.addEnum(e);
+    }
+
+    /**
+     * The declared name of a possibly nested declarator such as
+     * {@code (*name)[4]}.
+     */
+    static String declaratorName(NoPointerDeclaratorContext ctx) {
+        while (ctx != null) {
+            if (ctx.declaratorid() != null)
+                return ctx.declaratorid().getText();
+            if (ctx.pointerDeclarator() != null)
+                ctx = ctx.pointerDeclarator().noPointerDeclarator();
+            else
+                ctx = ctx.noPointerDeclarator();
+        }
+        return "";
+    }
+
+    private String currentScope() {
+        StringBuilder sb = new StringBuilder();
+        Iterator<String> outermostFirst = scopes.descendingIterator();
+        while (outermostFirst.hasNext()) {
+            String scope = outermostFirst.next();
+            if (scope.isEmpty())
+                continue;
+            if (sb.length() > 0)
+                sb.append("::");
+            sb.append(scope);
+        }
+        return sb.toString();
     }
 }
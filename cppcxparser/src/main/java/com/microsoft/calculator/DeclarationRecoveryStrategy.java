@@ -0,0 +1,234 @@
+package com.microsoft.calculator;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser.TranslationUnitContext;
+
+import org.antlr.v4.runtime.DefaultErrorStrategy;
+import org.antlr.v4.runtime.InputMismatchException;
+import org.antlr.v4.runtime.Parser;
+import org.antlr.v4.runtime.RecognitionException;
+import org.antlr.v4.runtime.RuleContext;
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.TokenStream;
+import org.antlr.v4.runtime.atn.ATN;
+import org.antlr.v4.runtime.atn.ATNState;
+import org.antlr.v4.runtime.atn.RuleTransition;
+import org.antlr.v4.runtime.misc.IntervalSet;
+
+/**
+ * An error strategy that gives up on the broken declaration instead of
+ * repairing it.
+ *
+ * {@link DefaultErrorStrategy} tries single token insertion and deletion at
+ * every mismatch and resynchronizes to the follow sets of the whole rule
+ * stack, which on unsupported constructs costs a lot and often cascades into
+ * further errors. This strategy never repairs a token. After an error it
+ * skips to the end of the declaration or statement at the error: to the next
+ * {@code ;} outside braces, or past the braces of a body opened after the
+ * error. A closing brace outside braces ends the skip without being
+ * consumed when an enclosing rule can close with it, and is dropped as stray
+ * otherwise; only a translation unit parse drops it, since a caller parsing
+ * single declarations owns what follows them. Enclosing rules then continue
+ * with the next declaration, member or statement.
+ *
+ * At most {@code maxErrors} errors are reported per file. On the next one
+ * the rest of the file is skipped, so pathological input costs one pass
+ * over its tokens. Errors are reported to the parser's listeners as usual;
+ * pair the strategy with a {@link DiagnosticCollector} rather than the
+ * console listener. One strategy per parser.
+ */
+public class DeclarationRecoveryStrategy extends DefaultErrorStrategy {
+
+    public static final int DEFAULT_MAX_ERRORS = 100;
+
+    private final int maxErrors;
+    /** Index at which the last skip ended, -1 before the first. */
+    private int lastSkipIndex = -1;
+    private boolean truncated;
+
+    public DeclarationRecoveryStrategy() {
+        this(DEFAULT_MAX_ERRORS);
+    }
+
+    public DeclarationRecoveryStrategy(int maxErrors) {
+        if (maxErrors < 1)
+            throw new IllegalArgumentException("maxErrors must be positive: " + maxErrors);
+        this.maxErrors = maxErrors;
+    }
+
+    public int getMaxErrors() {
+        return maxErrors;
+    }
+
+    /**
+     * Whether the rest of the file was skipped after too many errors.
+     */
+    public boolean isTruncated() {
+        return truncated;
+    }
+
+    @Override
+    public void reset(Parser recognizer) {
+        super.reset(recognizer);
+        lastSkipIndex = -1;
+        truncated = false;
+    }
+
+    @Override
+    public void reportError(Parser recognizer, RecognitionException e) {
+        if (recognizer.getNumberOfSyntaxErrors() < maxErrors)
+            super.reportError(recognizer, e);
+    }
+
+    /**
+     * Fails the rule instead of repairing the token.
+     */
+    @Override
+    public Token recoverInline(Parser recognizer) throws RecognitionException {
+        throw new InputMismatchException(recognizer);
+    }
+
+    @Override
+    public void recover(Parser recognizer, RecognitionException e) {
+        TokenStream input = recognizer.getInputStream();
+        if (tooManyErrors(recognizer)) {
+            skipRest(recognizer);
+            return;
+        }
+        int index = input.index();
+        if (lastErrorIndex == index && lastErrorStates != null && lastErrorStates.contains(recognizer.getState())) {
+            // Failed again at the same place: no enclosing rule accepts the token.
+            recognizer.consume();
+        } else if (index == lastSkipIndex) {
+            // An enclosing rule of the one that skipped; the next token
+            // starts whatever follows, so let the rules return to it.
+            lastErrorIndex = index;
+            if (lastErrorStates == null)
+                lastErrorStates = new IntervalSet();
+            lastErrorStates.add(recognizer.getState());
+            return;
+        }
+        lastErrorIndex = input.index();
+        lastErrorStates = new IntervalSet();
+        lastErrorStates.add(recognizer.getState());
+        skip(recognizer);
+    }
+
+    /**
+     * At loops and optional blocks, drops tokens that nothing on the rule
+     * stack can continue with, so the loop goes on with the next
+     * declaration, member or statement.
+     */
+    @Override
+    public void sync(Parser recognizer) throws RecognitionException {
+        ATN atn = recognizer.getInterpreter().atn;
+        ATNState s = atn.states.get(recognizer.getState());
+        switch (s.getStateType()) {
+        case ATNState.BLOCK_START:
+        case ATNState.STAR_BLOCK_START:
+        case ATNState.PLUS_BLOCK_START:
+        case ATNState.STAR_LOOP_ENTRY:
+        case ATNState.PLUS_LOOP_BACK:
+        case ATNState.STAR_LOOP_BACK:
+            break;
+        default:
+            return;
+        }
+        TokenStream input = recognizer.getInputStream();
+        IntervalSet next = atn.nextTokens(s);
+        int la = input.LA(1);
+        if (la == Token.EOF || next.contains(la))
+            return;
+        if (!next.contains(Token.EPSILON))
+            throw new InputMismatchException(recognizer);
+        if (isExpected(recognizer, next, la))
+            return;
+
+        if (tooManyErrors(recognizer)) {
+            skipRest(recognizer);
+            return;
+        }
+        reportUnwantedToken(recognizer);
+        do {
+            if (la == CPPCXLexer.RightBrace && closesEnclosingRule(recognizer))
+                return;
+            skip(recognizer);
+            la = input.LA(1);
+        } while (la != Token.EOF && !next.contains(la) && !isExpected(recognizer, next, la));
+    }
+
+    /**
+     * Whether the token may follow where the rules on the stack can end,
+     * given the tokens that may come next in the current rule.
+     */
+    private static boolean isExpected(Parser recognizer, IntervalSet next, int la) {
+        ATN atn = recognizer.getInterpreter().atn;
+        IntervalSet following = next;
+        for (RuleContext ctx = recognizer.getContext(); following.contains(Token.EPSILON); ctx = ctx.parent) {
+            if (ctx == null || ctx.invokingState < 0)
+                return false;
+            RuleTransition rt = (RuleTransition) atn.states.get(ctx.invokingState).transition(0);
+            following = atn.nextTokens(rt.followState);
+            if (following.contains(la))
+                return true;
+        }
+        return false;
+    }
+
+    private boolean tooManyErrors(Parser recognizer) {
+        return recognizer.getNumberOfSyntaxErrors() >= maxErrors;
+    }
+
+    private void skipRest(Parser recognizer) {
+        truncated = true;
+        while (recognizer.getInputStream().LA(1) != Token.EOF)
+            recognizer.consume();
+        lastSkipIndex = recognizer.getInputStream().index();
+    }
+
+    /**
+     * Skips to the end of the declaration or statement.
+     */
+    private void skip(Parser recognizer) {
+        TokenStream input = recognizer.getInputStream();
+        int depth = 0;
+        while (true) {
+            int la = input.LA(1);
+            if (la == Token.EOF)
+                break;
+            if (la == CPPCXLexer.LeftBrace) {
+                depth++;
+            } else if (la == CPPCXLexer.RightBrace) {
+                if (depth == 0) {
+                    if (!closesEnclosingRule(recognizer))
+                        recognizer.consume();
+                    break;
+                }
+                if (--depth == 0) {
+                    recognizer.consume();
+                    break;
+                }
+            } else if (la == CPPCXLexer.Semi && depth == 0) {
+                recognizer.consume();
+                break;
+            }
+            recognizer.consume();
+        }
+        lastSkipIndex = input.index();
+    }
+
+    /**
+     * Whether a rule on the stack can continue with a closing brace, or the
+     * parse did not start at the translation unit.
+     */
+    private static boolean closesEnclosingRule(Parser recognizer) {
+        ATN atn = recognizer.getInterpreter().atn;
+        RuleContext ctx = recognizer.getContext();
+        for (; ctx != null && ctx.invokingState >= 0; ctx = ctx.parent) {
+            RuleTransition rt = (RuleTransition) atn.states.get(ctx.invokingState).transition(0);
+            if (atn.nextTokens(rt.followState).contains(CPPCXLexer.RightBrace))
+                return true;
+        }
+        return !(ctx instanceof TranslationUnitContext);
+    }
+}
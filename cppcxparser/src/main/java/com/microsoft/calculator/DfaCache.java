@@ -0,0 +1,566 @@
+package com.microsoft.calculator;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.lang.reflect.Field;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.BitSet;
+import java.util.HashMap;
+import java.util.IdentityHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Objects;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.TokenSource;
+import org.antlr.v4.runtime.TokenStream;
+import org.antlr.v4.runtime.atn.ATN;
+import org.antlr.v4.runtime.atn.ATNConfig;
+import org.antlr.v4.runtime.atn.ATNConfigSet;
+import org.antlr.v4.runtime.atn.ATNSimulator;
+import org.antlr.v4.runtime.atn.ArrayPredictionContext;
+import org.antlr.v4.runtime.atn.ParserATNSimulator;
+import org.antlr.v4.runtime.atn.PredictionContext;
+import org.antlr.v4.runtime.atn.PredictionContextCache;
+import org.antlr.v4.runtime.atn.SemanticContext;
+import org.antlr.v4.runtime.atn.SingletonPredictionContext;
+import org.antlr.v4.runtime.dfa.DFA;
+import org.antlr.v4.runtime.dfa.DFAState;
+
+/**
+ * Warms up and persists the prediction DFA that all {@link CPPCXParser}
+ * instances of a JVM share.
+ *
+ * ANTLR builds the DFA lazily, so the first files a JVM parses pay for ATN
+ * simulation that later files get from the cache. {@link #warmUp()} parses
+ * the bundled example to pay that cost up front; {@link #save} and
+ * {@link #load} carry a warmed-up DFA over to a new JVM. The cache file is
+ * tied to the serialized parser ATN and is rejected after a grammar change.
+ *
+ * Only the parser DFA is persisted. The lexer DFA is small and is rebuilt by
+ * the first few files. Saving and loading must not run concurrently with
+ * parsing.
+ */
+public final class DfaCache {
+
+    private static final int MAGIC = 0x43584446;
+    private static final int VERSION = 1;
+
+    private static final int CONTEXT_EMPTY = 0;
+    private static final int CONTEXT_SINGLETON = 1;
+    private static final int CONTEXT_ARRAY = 2;
+
+    private static final int SEMANTIC_NONE = 0;
+    private static final int SEMANTIC_PREDICATE = 1;
+    private static final int SEMANTIC_PRECEDENCE = 2;
+    private static final int SEMANTIC_AND = 3;
+    private static final int SEMANTIC_OR = 4;
+
+    private static final int EDGE_ERROR = -1;
+
+    private static final Field CONFLICTING_ALTS = conflictingAltsField();
+
+    private DfaCache() {
+    }
+
+    /**
+     * Parses the bundled example.cpp to populate the shared DFA.
+     */
+    public static void warmUp() throws IOException {
+        try (InputStream is = DfaCache.class.getResourceAsStream("/example.cpp")) {
+            warmUp(CharStreams.fromStream(is));
+        }
+    }
+
+    /**
+     * Parses the input the way the batch parser does by default, with the
+     * {@link MacroTable#calculatorDefaults()} expanded, discarding the
+     * result; unexpanded, the calculator macros would warm decisions that
+     * the expanded files never take.
+     */
+    public static void warmUp(CharStream input) {
+        TokenSource source = new MacroExpandingTokenSource(new CPPCXLexer(input), MacroTable.calculatorDefaults());
+        CPPCXParser parser = new CPPCXParser(new CommonTokenStream(source));
+        parser.removeErrorListeners();
+        new TwoStageParser().parse(parser);
+    }
+
+    /**
+     * Number of DFA states over all decisions.
+     */
+    public static int stateCount() {
+        int count = 0;
+        for (DFA dfa : interpreter().decisionToDFA) {
+            synchronized (dfa.states) {
+                count += dfa.states.size();
+            }
+        }
+        return count;
+    }
+
+    public static void save(Path file) throws IOException {
+        Path temp = Files.createTempFile(file.toAbsolutePath().getParent(), file.getFileName().toString(), ".tmp");
+        try {
+            try (OutputStream out = Files.newOutputStream(temp)) {
+                save(out);
+            }
+            Files.move(temp, file, StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+        } finally {
+            Files.deleteIfExists(temp);
+        }
+    }
+
+    public static int load(Path file) throws IOException {
+        try (InputStream in = Files.newInputStream(file)) {
+            return load(in);
+        }
+    }
+
+    public static void save(OutputStream stream) throws IOException {
+        DFA[] decisions = interpreter().decisionToDFA;
+        DataOutputStream out = new DataOutputStream(new BufferedOutputStream(stream));
+        out.writeInt(MAGIC);
+        out.writeInt(VERSION);
+        out.writeInt(grammarHash());
+        out.writeInt(decisions.length);
+
+        // Contexts are written first, parents before children, so that every
+        // state can refer to them by index.
+        Map<PredictionContext, Integer> contextIds = new IdentityHashMap<>();
+        List<PredictionContext> contexts = new ArrayList<>();
+        List<List<DFAState>> statesByDecision = new ArrayList<>(decisions.length);
+        for (DFA dfa : decisions) {
+            List<DFAState> states;
+            synchronized (dfa.states) {
+                states = new ArrayList<>(dfa.states.values());
+            }
+            for (DFAState state : states) {
+                for (ATNConfig config : state.configs)
+                    contextId(config.context, contextIds, contexts);
+            }
+            statesByDecision.add(states);
+        }
+
+        out.writeInt(contexts.size());
+        for (PredictionContext context : contexts)
+            writeContext(out, context, contextIds);
+
+        for (int decision = 0; decision < decisions.length; decision++)
+            writeDfa(out, decisions[decision], statesByDecision.get(decision), contextIds);
+        out.flush();
+    }
+
+    /**
+     * Merges a saved DFA into the shared one and returns the number of states
+     * added.
+     *
+     * @throws IOException if the data is not a DFA cache or was saved by a
+     *                     different grammar
+     */
+    public static int load(InputStream stream) throws IOException {
+        ParserATNSimulator interpreter = interpreter();
+        DFA[] decisions = interpreter.decisionToDFA;
+        DataInputStream in = new DataInputStream(new BufferedInputStream(stream));
+        if (in.readInt() != MAGIC || in.readInt() != VERSION)
+            throw new IOException("not a DFA cache");
+        if (in.readInt() != grammarHash() || in.readInt() != decisions.length)
+            throw new IOException("DFA cache was saved by a different grammar");
+
+        PredictionContextCache contextCache = interpreter.getSharedContextCache();
+        PredictionContext[] contexts = new PredictionContext[in.readInt()];
+        for (int i = 0; i < contexts.length; i++)
+            contexts[i] = contextCache.add(readContext(in, contexts));
+
+        int added = 0;
+        for (DFA dfa : decisions)
+            added += readDfa(in, dfa, interpreter.atn, contexts);
+        return added;
+    }
+
+    private static void writeDfa(DataOutputStream out, DFA dfa, List<DFAState> states,
+            Map<PredictionContext, Integer> contextIds) throws IOException {
+        Map<DFAState, Integer> ordinals = new IdentityHashMap<>();
+        out.writeInt(states.size());
+        for (DFAState state : states) {
+            ordinals.put(state, ordinals.size());
+            writeState(out, state, contextIds);
+        }
+
+        for (DFAState state : states) {
+            DFAState[] edges = state.edges;
+            if (edges == null) {
+                out.writeInt(-1);
+                continue;
+            }
+            edges = edges.clone();
+            int count = 0;
+            for (DFAState target : edges) {
+                if (target != null && (target == ATNSimulator.ERROR || ordinals.containsKey(target)))
+                    count++;
+            }
+            out.writeInt(edges.length);
+            out.writeInt(count);
+            for (int i = 0; i < edges.length; i++) {
+                DFAState target = edges[i];
+                if (target == ATNSimulator.ERROR) {
+                    out.writeInt(i);
+                    out.writeInt(EDGE_ERROR);
+                } else if (target != null && ordinals.containsKey(target)) {
+                    out.writeInt(i);
+                    out.writeInt(ordinals.get(target));
+                }
+            }
+        }
+
+        // Precedence DFAs keep one start state per precedence level.
+        List<int[]> starts = new ArrayList<>();
+        if (dfa.isPrecedenceDfa()) {
+            DFAState[] precedenceStarts = dfa.s0.edges.clone();
+            for (int precedence = 0; precedence < precedenceStarts.length; precedence++) {
+                Integer ordinal = ordinals.get(precedenceStarts[precedence]);
+                if (ordinal != null)
+                    starts.add(new int[] { precedence, ordinal });
+            }
+        } else {
+            Integer ordinal = dfa.s0 == null ? null : ordinals.get(dfa.s0);
+            if (ordinal != null)
+                starts.add(new int[] { -1, ordinal });
+        }
+        out.writeInt(starts.size());
+        for (int[] start : starts) {
+            out.writeInt(start[0]);
+            out.writeInt(start[1]);
+        }
+    }
+
+    private static int readDfa(DataInputStream in, DFA dfa, ATN atn, PredictionContext[] contexts) throws IOException {
+        DFAState[] states = new DFAState[in.readInt()];
+        int added = 0;
+        synchronized (dfa.states) {
+            Map<StateKey, ArrayDeque<DFAState>> unmatched = new HashMap<>();
+            for (DFAState state : dfa.states.keySet()) {
+                StateKey key = new StateKey(state);
+                ArrayDeque<DFAState> equal = unmatched.get(key);
+                if (equal == null) {
+                    equal = new ArrayDeque<>();
+                    unmatched.put(key, equal);
+                }
+                equal.add(state);
+            }
+            for (int i = 0; i < states.length; i++) {
+                DFAState state = readState(in, atn, contexts);
+                ArrayDeque<DFAState> equal = unmatched.get(new StateKey(state));
+                DFAState existing = equal == null ? null : equal.poll();
+                if (existing != null) {
+                    states[i] = existing;
+                } else {
+                    state.stateNumber = dfa.states.size();
+                    dfa.states.put(state, state);
+                    states[i] = state;
+                    added++;
+                }
+            }
+        }
+
+        for (DFAState state : states) {
+            int length = in.readInt();
+            if (length < 0)
+                continue;
+            int count = in.readInt();
+            synchronized (state) {
+                if (state.edges == null)
+                    state.edges = new DFAState[length];
+                for (int i = 0; i < count; i++) {
+                    int symbol = in.readInt();
+                    int target = in.readInt();
+                    if (symbol < state.edges.length && state.edges[symbol] == null)
+                        state.edges[symbol] = target == EDGE_ERROR ? ATNSimulator.ERROR : states[target];
+                }
+            }
+        }
+
+        int startCount = in.readInt();
+        for (int i = 0; i < startCount; i++) {
+            int precedence = in.readInt();
+            DFAState start = states[in.readInt()];
+            if (dfa.isPrecedenceDfa()) {
+                if (dfa.getPrecedenceStartState(precedence) == null)
+                    dfa.setPrecedenceStartState(precedence, start);
+            } else if (dfa.s0 == null) {
+                dfa.s0 = start;
+            }
+        }
+        return added;
+    }
+
+    private static void writeState(DataOutputStream out, DFAState state, Map<PredictionContext, Integer> contextIds)
+            throws IOException {
+        ATNConfigSet configs = state.configs;
+        out.writeBoolean(configs.fullCtx);
+        out.writeInt(configs.size());
+        for (ATNConfig config : configs) {
+            out.writeInt(config.state.stateNumber);
+            out.writeInt(config.alt);
+            out.writeInt(contextIds.get(config.context));
+            out.writeInt(config.reachesIntoOuterContext);
+            writeSemanticContext(out, config.semanticContext);
+        }
+        out.writeInt(configs.uniqueAlt);
+        out.writeBoolean(configs.hasSemanticContext);
+        out.writeBoolean(configs.dipsIntoOuterContext);
+        writeBitSet(out, conflictingAlts(configs));
+
+        out.writeBoolean(state.isAcceptState);
+        out.writeInt(state.prediction);
+        out.writeBoolean(state.requiresFullContext);
+        if (state.predicates == null) {
+            out.writeInt(-1);
+        } else {
+            out.writeInt(state.predicates.length);
+            for (DFAState.PredPrediction prediction : state.predicates) {
+                writeSemanticContext(out, prediction.pred);
+                out.writeInt(prediction.alt);
+            }
+        }
+    }
+
+    private static DFAState readState(DataInputStream in, ATN atn, PredictionContext[] contexts) throws IOException {
+        ATNConfigSet configs = new ATNConfigSet(in.readBoolean());
+        int count = in.readInt();
+        for (int i = 0; i < count; i++) {
+            int stateNumber = in.readInt();
+            int alt = in.readInt();
+            PredictionContext context = contexts[in.readInt()];
+            int reachesIntoOuterContext = in.readInt();
+            ATNConfig config = new ATNConfig(atn.states.get(stateNumber), alt, context, readSemanticContext(in));
+            config.reachesIntoOuterContext = reachesIntoOuterContext;
+            configs.add(config);
+        }
+        configs.uniqueAlt = in.readInt();
+        configs.hasSemanticContext = in.readBoolean();
+        configs.dipsIntoOuterContext = in.readBoolean();
+        setConflictingAlts(configs, readBitSet(in));
+        configs.setReadonly(true);
+
+        DFAState state = new DFAState(configs);
+        state.isAcceptState = in.readBoolean();
+        state.prediction = in.readInt();
+        state.requiresFullContext = in.readBoolean();
+        int predicates = in.readInt();
+        if (predicates >= 0) {
+            state.predicates = new DFAState.PredPrediction[predicates];
+            for (int i = 0; i < predicates; i++) {
+                SemanticContext pred = readSemanticContext(in);
+                state.predicates[i] = new DFAState.PredPrediction(pred, in.readInt());
+            }
+        }
+        return state;
+    }
+
+    private static int contextId(PredictionContext context, Map<PredictionContext, Integer> ids,
+            List<PredictionContext> ordered) {
+        if (context == null)
+            return -1;
+        Integer id = ids.get(context);
+        if (id != null)
+            return id;
+        if (!context.isEmpty()) {
+            for (int i = 0; i < context.size(); i++)
+                contextId(context.getParent(i), ids, ordered);
+        }
+        ids.put(context, ordered.size());
+        ordered.add(context);
+        return ordered.size() - 1;
+    }
+
+    private static void writeContext(DataOutputStream out, PredictionContext context, Map<PredictionContext, Integer> ids)
+            throws IOException {
+        if (context.isEmpty()) {
+            out.writeByte(CONTEXT_EMPTY);
+            return;
+        }
+        out.writeByte(context instanceof SingletonPredictionContext ? CONTEXT_SINGLETON : CONTEXT_ARRAY);
+        out.writeInt(context.size());
+        for (int i = 0; i < context.size(); i++) {
+            PredictionContext parent = context.getParent(i);
+            out.writeInt(parent == null ? -1 : ids.get(parent));
+            out.writeInt(context.getReturnState(i));
+        }
+    }
+
+    private static PredictionContext readContext(DataInputStream in, PredictionContext[] contexts) throws IOException {
+        int kind = in.readByte();
+        if (kind == CONTEXT_EMPTY)
+            return PredictionContext.EMPTY;
+        int size = in.readInt();
+        PredictionContext[] parents = new PredictionContext[size];
+        int[] returnStates = new int[size];
+        for (int i = 0; i < size; i++) {
+            int parent = in.readInt();
+            parents[i] = parent < 0 ? null : contexts[parent];
+            returnStates[i] = in.readInt();
+        }
+        if (kind == CONTEXT_SINGLETON)
+            return SingletonPredictionContext.create(parents[0], returnStates[0]);
+        return new ArrayPredictionContext(parents, returnStates);
+    }
+
+    private static void writeSemanticContext(DataOutputStream out, SemanticContext context) throws IOException {
+        if (context == SemanticContext.NONE) {
+            out.writeByte(SEMANTIC_NONE);
+        } else if (context instanceof SemanticContext.Predicate) {
+            SemanticContext.Predicate predicate = (SemanticContext.Predicate) context;
+            out.writeByte(SEMANTIC_PREDICATE);
+            out.writeInt(predicate.ruleIndex);
+            out.writeInt(predicate.predIndex);
+            out.writeBoolean(predicate.isCtxDependent);
+        } else if (context instanceof SemanticContext.PrecedencePredicate) {
+            out.writeByte(SEMANTIC_PRECEDENCE);
+            out.writeInt(((SemanticContext.PrecedencePredicate) context).precedence);
+        } else if (context instanceof SemanticContext.AND) {
+            writeOperands(out, SEMANTIC_AND, ((SemanticContext.AND) context).opnds);
+        } else if (context instanceof SemanticContext.OR) {
+            writeOperands(out, SEMANTIC_OR, ((SemanticContext.OR) context).opnds);
+        } else {
+            throw new IOException("unsupported semantic context " + context.getClass().getName());
+        }
+    }
+
+    private static void writeOperands(DataOutputStream out, int kind, SemanticContext[] operands) throws IOException {
+        out.writeByte(kind);
+        out.writeInt(operands.length);
+        for (SemanticContext operand : operands)
+            writeSemanticContext(out, operand);
+    }
+
+    private static SemanticContext readSemanticContext(DataInputStream in) throws IOException {
+        int kind = in.readByte();
+        switch (kind) {
+        case SEMANTIC_NONE:
+            return SemanticContext.NONE;
+        case SEMANTIC_PREDICATE:
+            int ruleIndex = in.readInt();
+            int predIndex = in.readInt();
+            return new SemanticContext.Predicate(ruleIndex, predIndex, in.readBoolean());
+        case SEMANTIC_PRECEDENCE:
+            return new SemanticContext.PrecedencePredicate(in.readInt());
+        case SEMANTIC_AND:
+        case SEMANTIC_OR:
+            int count = in.readInt();
+            SemanticContext result = readSemanticContext(in);
+            for (int i = 1; i < count; i++) {
+                SemanticContext operand = readSemanticContext(in);
+                result = kind == SEMANTIC_AND ? SemanticContext.and(result, operand) : SemanticContext.or(result, operand);
+            }
+            return result;
+        default:
+            throw new IOException("corrupt DFA cache: semantic context " + kind);
+        }
+    }
+
+    private static void writeBitSet(DataOutputStream out, BitSet bits) throws IOException {
+        if (bits == null) {
+            out.writeInt(-1);
+            return;
+        }
+        long[] words = bits.toLongArray();
+        out.writeInt(words.length);
+        for (long word : words)
+            out.writeLong(word);
+    }
+
+    private static BitSet readBitSet(DataInputStream in) throws IOException {
+        int length = in.readInt();
+        if (length < 0)
+            return null;
+        long[] words = new long[length];
+        for (int i = 0; i < length; i++)
+            words[i] = in.readLong();
+        return BitSet.valueOf(words);
+    }
+
+    // ATNConfigSet.conflictingAlts is protected; it takes part in equals(), so
+    // restored states only match freshly built ones if it is carried over.
+    private static Field conflictingAltsField() {
+        try {
+            Field field = ATNConfigSet.class.getDeclaredField("conflictingAlts");
+            field.setAccessible(true);
+            return field;
+        } catch (NoSuchFieldException | SecurityException e) {
+            return null;
+        }
+    }
+
+    private static BitSet conflictingAlts(ATNConfigSet configs) {
+        if (CONFLICTING_ALTS == null)
+            return null;
+        try {
+            return (BitSet) CONFLICTING_ALTS.get(configs);
+        } catch (IllegalAccessException e) {
+            return null;
+        }
+    }
+
+    private static void setConflictingAlts(ATNConfigSet configs, BitSet alts) {
+        if (CONFLICTING_ALTS == null)
+            return;
+        try {
+            CONFLICTING_ALTS.set(configs, alts);
+        } catch (IllegalAccessException e) {
+            // leave it unset; such states are rebuilt on demand
+        }
+    }
+
+    /**
+     * Compares DFA states by value. ATNConfigSet.equals() compares the
+     * conflicting alternatives by identity, so a restored conflict state
+     * never equals the state it was saved from. Each existing state is
+     * matched at most once, since the simulator itself may have built
+     * several such copies.
+     */
+    private static final class StateKey {
+        private final DFAState state;
+
+        StateKey(DFAState state) {
+            this.state = state;
+        }
+
+        @Override
+        public int hashCode() {
+            return state.configs.configs.hashCode();
+        }
+
+        @Override
+        public boolean equals(Object o) {
+            if (!(o instanceof StateKey))
+                return false;
+            ATNConfigSet a = state.configs;
+            ATNConfigSet b = ((StateKey) o).state.configs;
+            return a.configs.equals(b.configs) && a.fullCtx == b.fullCtx && a.uniqueAlt == b.uniqueAlt
+                    && a.hasSemanticContext == b.hasSemanticContext && a.dipsIntoOuterContext == b.dipsIntoOuterContext
+                    && Objects.equals(conflictingAlts(a), conflictingAlts(b));
+        }
+    }
+
+    private static int grammarHash() {
+        return CPPCXParser._serializedATN.hashCode();
+    }
+
+    private static ParserATNSimulator interpreter() {
+        return new CPPCXParser((TokenStream) null).getInterpreter();
+    }
+}
@@ -0,0 +1,143 @@
+package com.microsoft.calculator;
+
+import java.io.IOException;
+import java.io.Serializable;
+import java.io.Writer;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.Locale;
+
+import org.antlr.v4.runtime.BaseErrorListener;
+import org.antlr.v4.runtime.Lexer;
+import org.antlr.v4.runtime.Parser;
+import org.antlr.v4.runtime.RecognitionException;
+import org.antlr.v4.runtime.Recognizer;
+import org.antlr.v4.runtime.Token;
+
+/**
+ * Collects the syntax errors of a lexer and parser as {@link Diagnostic}s
+ * instead of printing them.
+ *
+ * Add the collector to both the lexer and the parser in place of the
+ * console listener. Not safe to share between threads.
+ */
+public class DiagnosticCollector extends BaseErrorListener {
+
+    private final List<Diagnostic> diagnostics = new ArrayList<>();
+
+    @Override
+    public void syntaxError(Recognizer<?, ?> recognizer, Object offendingSymbol, int line, int charPositionInLine,
+            String msg, RecognitionException e) {
+        String source = recognizer.getInputStream() == null ? "" : recognizer.getInputStream().getSourceName();
+        String rule = recognizer instanceof Parser && ((Parser) recognizer).getContext() != null
+                ? recognizer.getRuleNames()[((Parser) recognizer).getContext().getRuleIndex()]
+                : null;
+        String token = offendingSymbol instanceof Token ? ((Token) offendingSymbol).getText() : null;
+        diagnostics.add(new Diagnostic(recognizer instanceof Lexer ? Diagnostic.Kind.LEXER : Diagnostic.Kind.PARSER,
+                source, line, charPositionInLine, msg, rule, token));
+    }
+
+    public List<Diagnostic> getDiagnostics() {
+        return Collections.unmodifiableList(diagnostics);
+    }
+
+    public void clear() {
+        diagnostics.clear();
+    }
+
+    /**
+     * Writes the diagnostics as a JSON array of objects with kind, source,
+     * line, column, message and, for parser errors, rule and token.
+     */
+    public static void writeJson(List<Diagnostic> diagnostics, Writer writer) throws IOException {
+        JsonWriter json = new JsonWriter(writer);
+        json.beginArray();
+        for (Diagnostic diagnostic : diagnostics)
+            diagnostic.write(json);
+        json.endArray();
+        json.flush();
+    }
+
+    /**
+     * One syntax error.
+     */
+    public static class Diagnostic implements Serializable {
+        private static final long serialVersionUID = 1L;
+
+        public enum Kind {
+            LEXER, PARSER
+        }
+
+        private final Kind kind;
+        private final String source;
+        private final int line;
+        private final int column;
+        private final String message;
+        private final String rule;
+        private final String token;
+
+        Diagnostic(Kind kind, String source, int line, int column, String message, String rule, String token) {
+            this.kind = kind;
+            this.source = source;
+            this.line = line;
+            this.column = column;
+            this.message = message;
+            this.rule = rule;
+            this.token = token;
+        }
+
+        public Kind getKind() {
+            return kind;
+        }
+
+        public String getSource() {
+            return source;
+        }
+
+        public int getLine() {
+            return line;
+        }
+
+        public int getColumn() {
+            return column;
+        }
+
+        public String getMessage() {
+            return message;
+        }
+
+        /**
+         * The rule the parser was in, or null for a lexer error.
+         */
+        public String getRule() {
+            return rule;
+        }
+
+        /**
+         * The text of the offending token, or null for a lexer error.
+         */
+        public String getToken() {
+            return token;
+        }
+
+        private void write(JsonWriter json) throws IOException {
+            json.beginObject();
+            json.name("kind").value(kind.name().toLowerCase(Locale.ROOT));
+            json.name("source").value(source);
+            json.name("line").value(line);
+            json.name("column").value(column);
+            json.name("message").value(message);
+            if (rule != null)
+                json.name("rule").value(rule);
+            if (token != null)
+                json.name("token").value(token);
+            json.endObject();
+        }
+
+        @Override
+        public String toString() {
+            return source + ":" + line + ":" + column + ": " + message;
+        }
+    }
+}
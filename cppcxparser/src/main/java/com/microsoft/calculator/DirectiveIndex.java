@@ -0,0 +1,122 @@
+package com.microsoft.calculator;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Locale;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+/**
+ * The {@code #include}, {@code #pragma once} and {@code #define} directives
+ * of a file, in source order.
+ *
+ * An entry takes two ints, its kind and line, and the included file or
+ * macro name; the directive text itself is not kept. Other directives are
+ * not recorded. Conditional compilation is not evaluated, so every
+ * directive counts.
+ */
+public class DirectiveIndex {
+
+    public enum Kind {
+        /** {@code #include "file"} */
+        INCLUDE,
+        /** {@code #include <file>} */
+        SYSTEM_INCLUDE,
+        PRAGMA_ONCE,
+        DEFINE
+    }
+
+    private static final Kind[] KINDS = Kind.values();
+    private static final Pattern INCLUDE = Pattern.compile("#\\s*include\\s*([\"<])([^\">]+)[\">]");
+    private static final Pattern PRAGMA_ONCE = Pattern.compile("#\\s*pragma\\s+once\\b");
+    private static final Pattern DEFINE = Pattern.compile("#\\s*define\\s+([A-Za-z_][A-Za-z0-9_]*)");
+
+    /** Kind ordinal and line of every entry. */
+    private int[] entries = new int[16];
+    private final List<String> names = new ArrayList<>();
+
+    /**
+     * Records the directive if it is one of the indexed kinds.
+     *
+     * @return whether it was recorded
+     */
+    public boolean add(String directive, int line) {
+        Matcher m = INCLUDE.matcher(directive);
+        if (m.lookingAt()) {
+            add(m.group(1).equals("\"") ? Kind.INCLUDE : Kind.SYSTEM_INCLUDE, line, m.group(2));
+            return true;
+        }
+        m = DEFINE.matcher(directive);
+        if (m.lookingAt()) {
+            add(Kind.DEFINE, line, m.group(1));
+            return true;
+        }
+        if (PRAGMA_ONCE.matcher(directive).lookingAt()) {
+            add(Kind.PRAGMA_ONCE, line, null);
+            return true;
+        }
+        return false;
+    }
+
+    private void add(Kind kind, int line, String name) {
+        int i = names.size() * 2;
+        if (i == entries.length)
+            entries = Arrays.copyOf(entries, i * 2);
+        entries[i] = kind.ordinal();
+        entries[i + 1] = line;
+        names.add(name);
+    }
+
+    public int size() {
+        return names.size();
+    }
+
+    public Kind getKind(int i) {
+        return KINDS[entries[i * 2]];
+    }
+
+    public int getLine(int i) {
+        return entries[i * 2 + 1];
+    }
+
+    /**
+     * The included file or defined macro, null for {@code #pragma once}.
+     */
+    public String getName(int i) {
+        return names.get(i);
+    }
+
+    public boolean hasPragmaOnce() {
+        for (int i = 0; i < size(); i++) {
+            if (getKind(i) == Kind.PRAGMA_ONCE)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * The names of the entries of the kind, in source order.
+     */
+    public List<String> getNames(Kind kind) {
+        List<String> result = new ArrayList<>();
+        for (int i = 0; i < size(); i++) {
+            if (getKind(i) == kind)
+                result.add(getName(i));
+        }
+        return result;
+    }
+
+    @Override
+    public String toString() {
+        StringBuilder sb = new StringBuilder();
+        for (int i = 0; i < size(); i++) {
+            if (i > 0)
+                sb.append(", ");
+            sb.append(getLine(i)).append(": ").append(getKind(i).name().toLowerCase(Locale.ROOT));
+            if (getName(i) != null)
+                sb.append(' ').append(getName(i));
+        }
+        return sb.toString();
+    }
+}
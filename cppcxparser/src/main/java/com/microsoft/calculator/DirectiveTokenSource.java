@@ -0,0 +1,75 @@
+package com.microsoft.calculator;
+
+import com.microsoft.CPPCXLexer;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.TokenFactory;
+import org.antlr.v4.runtime.TokenSource;
+
+/**
+ * Takes the preprocessor directives out of the token stream and records
+ * them in a {@link DirectiveIndex}.
+ *
+ * The lexer puts {@code Directive} and {@code MultiLineMacro} tokens on the
+ * hidden channel, where a token stream buffers them with the rest of the
+ * file although the parser never reads them. Wrapped around the lexer, this
+ * source passes on every other token and keeps only the index entry of a
+ * directive. One source per file.
+ */
+public class DirectiveTokenSource implements TokenSource {
+
+    private final TokenSource source;
+    private final DirectiveIndex index = new DirectiveIndex();
+
+    public DirectiveTokenSource(TokenSource source) {
+        this.source = source;
+    }
+
+    /**
+     * The directives read so far.
+     */
+    public DirectiveIndex getIndex() {
+        return index;
+    }
+
+    @Override
+    public Token nextToken() {
+        while (true) {
+            Token token = source.nextToken();
+            if (token.getType() != CPPCXLexer.Directive && token.getType() != CPPCXLexer.MultiLineMacro)
+                return token;
+            index.add(token.getText(), token.getLine());
+        }
+    }
+
+    @Override
+    public int getLine() {
+        return source.getLine();
+    }
+
+    @Override
+    public int getCharPositionInLine() {
+        return source.getCharPositionInLine();
+    }
+
+    @Override
+    public CharStream getInputStream() {
+        return source.getInputStream();
+    }
+
+    @Override
+    public String getSourceName() {
+        return source.getSourceName();
+    }
+
+    @Override
+    public void setTokenFactory(TokenFactory<?> factory) {
+        source.setTokenFactory(factory);
+    }
+
+    @Override
+    public TokenFactory<?> getTokenFactory() {
+        return source.getTokenFactory();
+    }
+}
@@ -0,0 +1,134 @@
+package com.microsoft.calculator;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+import com.microsoft.CPPCXParser.*;
+import com.microsoft.CPPCXParserBaseListener;
+
+import org.antlr.v4.runtime.ParserRuleContext;
+import org.antlr.v4.runtime.tree.ParseTree;
+
+/**
+ * Reports binary expressions the way the former one-rule-per-precedence-level
+ * grammar shaped them.
+ *
+ * {@code binaryExpression} nests one context per operator, so {@code a + b - c}
+ * is a subtraction whose left operand is an addition. The old
+ * {@code additiveExpression} rule held all three operands in one context.
+ * This listener calls {@link #enterOperatorChain} and
+ * {@link #exitOperatorChain} once for each such chain of operators of one
+ * level, with its operands from left to right, which is what code written
+ * against the old rules expected. Unlike the old rules, an operand without
+ * any operator does not start a chain.
+ *
+ * Subclasses that override {@link #enterEveryRule} or {@link #exitEveryRule}
+ * must call the super method.
+ */
+public class ExpressionCompatListener extends CPPCXParserBaseListener {
+
+    /**
+     * The precedence levels, named after the rules they replace.
+     */
+    public enum Level {
+        POINTER_MEMBER(PointerMemberExpressionContext.class),
+        MULTIPLICATIVE(MultiplicativeExpressionContext.class),
+        ADDITIVE(AdditiveExpressionContext.class),
+        SHIFT(ShiftExpressionContext.class),
+        RELATIONAL(RelationalExpressionContext.class),
+        EQUALITY(EqualityExpressionContext.class),
+        AND(AndExpressionContext.class),
+        EXCLUSIVE_OR(ExclusiveOrExpressionContext.class),
+        INCLUSIVE_OR(InclusiveOrExpressionContext.class),
+        LOGICAL_AND(LogicalAndExpressionContext.class),
+        LOGICAL_OR(LogicalOrExpressionContext.class);
+
+        private final Class<? extends BinaryExpressionContext> contextClass;
+
+        Level(Class<? extends BinaryExpressionContext> contextClass) {
+            this.contextClass = contextClass;
+        }
+
+        /**
+         * The level of a binary expression context, or null for an operand
+         * that is not a binary operation.
+         */
+        public static Level of(ParserRuleContext ctx) {
+            for (Level level : values()) {
+                if (level.contextClass == ctx.getClass())
+                    return level;
+            }
+            return null;
+        }
+    }
+
+    /**
+     * Called before the chain is walked.
+     *
+     * @param chain the outermost context of the chain, which spans all of it
+     * @param operands the operands from left to right, one more than there
+     *        are operators
+     * @param operators the operator of each operation from left to right: a
+     *        terminal, or a {@link ShiftOperatorContext}
+     */
+    public void enterOperatorChain(Level level, BinaryExpressionContext chain, List<BinaryExpressionContext> operands,
+            List<ParseTree> operators) {
+    }
+
+    public void exitOperatorChain(Level level, BinaryExpressionContext chain) {
+    }
+
+    @Override
+    public void enterEveryRule(ParserRuleContext ctx) {
+        Level level = chainLevel(ctx);
+        if (level == null)
+            return;
+        List<BinaryExpressionContext> operands = new ArrayList<>();
+        List<ParseTree> operators = new ArrayList<>();
+        BinaryExpressionContext operation = (BinaryExpressionContext) ctx;
+        while (true) {
+            operands.add((BinaryExpressionContext) operation.getChild(2));
+            operators.add(operation.getChild(1));
+            BinaryExpressionContext left = (BinaryExpressionContext) operation.getChild(0);
+            if (left.getClass() != operation.getClass() || !isOperation(left)) {
+                operands.add(left);
+                break;
+            }
+            operation = left;
+        }
+        Collections.reverse(operands);
+        Collections.reverse(operators);
+        enterOperatorChain(level, (BinaryExpressionContext) ctx, operands, operators);
+    }
+
+    @Override
+    public void exitEveryRule(ParserRuleContext ctx) {
+        Level level = chainLevel(ctx);
+        if (level != null)
+            exitOperatorChain(level, (BinaryExpressionContext) ctx);
+    }
+
+    /**
+     * The level of a context that starts a chain, that is a binary operation
+     * which is not the left operand of an operation of the same level.
+     */
+    private static Level chainLevel(ParserRuleContext ctx) {
+        Level level = Level.of(ctx);
+        if (level == null || !isOperation(ctx))
+            return null;
+        ParserRuleContext parent = ctx.getParent();
+        if (parent != null && parent.getClass() == ctx.getClass() && parent.getChild(0) == ctx
+                && isOperation(parent))
+            return null;
+        return level;
+    }
+
+    /**
+     * Whether error recovery left both operands in place.
+     */
+    private static boolean isOperation(ParserRuleContext ctx) {
+        return ctx.getChildCount() == 3 && ctx.getChild(0) instanceof BinaryExpressionContext
+                && ctx.getChild(2) instanceof BinaryExpressionContext;
+    }
+}
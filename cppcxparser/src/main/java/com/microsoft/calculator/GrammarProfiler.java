@@ -0,0 +1,346 @@
+package com.microsoft.calculator;
+
+import java.io.IOException;
+import java.io.PrintStream;
+import java.io.Reader;
+import java.io.Writer;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Properties;
+import java.util.TreeMap;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.TokenSource;
+import org.antlr.v4.runtime.atn.PredictionMode;
+
+/**
+ * Profiles the decisions of CPPCXParser.g4 over a corpus and compares them
+ * with a stored baseline, so that a grammar change that makes prediction
+ * harder is noticed.
+ *
+ * Every file is parsed with full LL prediction, as the second stage of a
+ * {@link TwoStageParser} does, by ANTLR's profiling ATN simulator. The
+ * report lists the ambiguous decisions, the LL fallbacks and context
+ * sensitivities per rule and the rules that spend the most time in
+ * prediction. With exact ambiguity detection, every ambiguity is reported
+ * instead of the first conflict per prediction, which is slower.
+ *
+ * The baseline is a properties file of the counts, which unlike the times
+ * do not depend on the machine. A count is a regression when it grows to at
+ * least the baseline times the factor, so with the default factor a count
+ * that doubles is one, and so is any count that was zero, such as the
+ * ambiguities of a rule, as soon as it appears.
+ *
+ * Usage: GrammarProfiler [--baseline file] [--update] [--factor f] [--exact] [--top n] [--no-macros] path...
+ *
+ * --update writes the counts of this run to the baseline instead of
+ * comparing them. The exit status is 1 if there are regressions and 2 if
+ * the baseline does not exist and --update is not given.
+ */
+public class GrammarProfiler {
+
+    public static final double DEFAULT_FACTOR = 2;
+
+    private static final String[] COUNTS = { "llFallback", "contextSensitivities", "ambiguities", "errors" };
+
+    private boolean exactAmbiguities;
+    private MacroTable macros;
+
+    /**
+     * Reports every ambiguity, see
+     * {@link PredictionMode#LL_EXACT_AMBIG_DETECTION}.
+     */
+    public void setExactAmbiguities(boolean exactAmbiguities) {
+        this.exactAmbiguities = exactAmbiguities;
+    }
+
+    /**
+     * Expands the macros before parsing, or null not to.
+     */
+    public void setMacros(MacroTable macros) {
+        this.macros = macros;
+    }
+
+    public Report profile(List<Path> files) throws IOException {
+        ParseStats stats = new ParseStats();
+        for (Path file : files) {
+            ParseStats.FileStats fileStats = new ParseStats.FileStats(file);
+            TokenSource source = new CPPCXLexer(CharStreams.fromPath(file, StandardCharsets.UTF_8));
+            if (macros != null)
+                source = new MacroExpandingTokenSource(source, macros);
+            CommonTokenStream tokens = new CommonTokenStream(source);
+            tokens.fill();
+            CPPCXParser parser = new CPPCXParser(tokens);
+            parser.removeErrorListeners();
+            parser.setProfile(true);
+            parser.getInterpreter().setPredictionMode(
+                    exactAmbiguities ? PredictionMode.LL_EXACT_AMBIG_DETECTION : PredictionMode.LL);
+            long start = System.nanoTime();
+            parser.translationUnit();
+            fileStats.parseNanos = System.nanoTime() - start;
+            fileStats.tokens = tokens.size();
+            fileStats.syntaxErrors = parser.getNumberOfSyntaxErrors();
+            stats.addFile(fileStats);
+            stats.addDecisions(parser.getParseInfo().getDecisionInfo());
+        }
+        return new Report(stats);
+    }
+
+    public static void main(String[] args) throws IOException {
+        Path baseline = null;
+        boolean update = false;
+        double factor = DEFAULT_FACTOR;
+        int top = 10;
+        GrammarProfiler profiler = new GrammarProfiler();
+        profiler.setMacros(MacroTable.calculatorDefaults());
+        List<Path> roots = new ArrayList<>();
+        for (int i = 0; i < args.length; i++) {
+            if (args[i].equals("--baseline") && i + 1 < args.length)
+                baseline = Paths.get(args[++i]);
+            else if (args[i].equals("--update"))
+                update = true;
+            else if (args[i].equals("--factor") && i + 1 < args.length)
+                factor = Double.parseDouble(args[++i]);
+            else if (args[i].equals("--exact"))
+                profiler.setExactAmbiguities(true);
+            else if (args[i].equals("--top") && i + 1 < args.length)
+                top = Integer.parseInt(args[++i]);
+            else if (args[i].equals("--no-macros"))
+                profiler.setMacros(null);
+            else
+                roots.add(Paths.get(args[i]));
+        }
+        if (baseline != null && !update && !Files.exists(baseline)) {
+            System.err.println("no baseline at " + baseline + ", write one with --update");
+            System.exit(2);
+        }
+
+        Report report = profiler.profile(BatchParser.collectSources(roots));
+        report.print(System.out, top);
+        if (baseline == null)
+            return;
+        if (update) {
+            report.writeBaseline(baseline);
+            System.out.println("baseline written to " + baseline);
+            return;
+        }
+        List<String> regressions = report.compare(Report.readBaseline(baseline), factor);
+        for (String regression : regressions)
+            System.out.println("regression: " + regression);
+        if (!regressions.isEmpty())
+            System.exit(1);
+        System.out.println("no regressions against " + baseline);
+    }
+
+    /**
+     * The decision statistics of a profiled corpus.
+     */
+    public static class Report {
+        private final ParseStats stats;
+        private final Map<String, RuleStats> rules = new LinkedHashMap<>();
+        private final RuleStats total = new RuleStats("total");
+
+        Report(ParseStats stats) {
+            this.stats = stats;
+            List<ParseStats.DecisionStats> decisions = stats.getDecisions();
+            for (ParseStats.DecisionStats decision : decisions) {
+                RuleStats rule = rules.get(decision.getRule());
+                if (rule == null) {
+                    rule = new RuleStats(decision.getRule());
+                    rules.put(decision.getRule(), rule);
+                }
+                rule.add(decision);
+                total.add(decision);
+            }
+        }
+
+        public List<ParseStats.FileStats> getFiles() {
+            return stats.getFiles();
+        }
+
+        public List<ParseStats.DecisionStats> getDecisions() {
+            return stats.getDecisions();
+        }
+
+        /**
+         * Decisions with ambiguities, most ambiguities first.
+         */
+        public List<ParseStats.DecisionStats> getAmbiguousDecisions() {
+            List<ParseStats.DecisionStats> ambiguous = new ArrayList<>();
+            for (ParseStats.DecisionStats decision : stats.getDecisions()) {
+                if (decision.getAmbiguities() > 0)
+                    ambiguous.add(decision);
+            }
+            Collections.sort(ambiguous, new Comparator<ParseStats.DecisionStats>() {
+                @Override
+                public int compare(ParseStats.DecisionStats a, ParseStats.DecisionStats b) {
+                    return Long.compare(b.getAmbiguities(), a.getAmbiguities());
+                }
+            });
+            return ambiguous;
+        }
+
+        /**
+         * The rules with predicted decisions, most time in prediction first.
+         */
+        public List<RuleStats> getRules() {
+            List<RuleStats> sorted = new ArrayList<>(rules.values());
+            Collections.sort(sorted, new Comparator<RuleStats>() {
+                @Override
+                public int compare(RuleStats a, RuleStats b) {
+                    return Long.compare(b.timeInPrediction, a.timeInPrediction);
+                }
+            });
+            return sorted;
+        }
+
+        public RuleStats getTotal() {
+            return total;
+        }
+
+        /**
+         * The counts as baseline entries; zero counts are left out.
+         */
+        public Map<String, Long> getCounts() {
+            Map<String, Long> counts = new TreeMap<>();
+            total.addCounts(counts, "total.");
+            for (RuleStats rule : rules.values())
+                rule.addCounts(counts, "rule." + rule.getRule() + ".");
+            return counts;
+        }
+
+        /**
+         * The counts that grew to at least the baseline times the factor, as
+         * {@code "key: baseline -> current"}.
+         */
+        public List<String> compare(Properties baseline, double factor) {
+            List<String> regressions = new ArrayList<>();
+            for (Map.Entry<String, Long> count : getCounts().entrySet()) {
+                long base = Long.parseLong(baseline.getProperty(count.getKey(), "0"));
+                if (count.getValue() > base && count.getValue() >= base * factor)
+                    regressions.add(count.getKey() + ": " + base + " -> " + count.getValue());
+            }
+            return regressions;
+        }
+
+        public void writeBaseline(Path file) throws IOException {
+            try (Writer writer = Files.newBufferedWriter(file, StandardCharsets.ISO_8859_1)) {
+                writer.write("# Decision counts of CPPCXParser.g4, see GrammarProfiler.\n");
+                writer.write("files=" + stats.getFiles().size() + "\n");
+                for (Map.Entry<String, Long> count : getCounts().entrySet())
+                    writer.write(count.getKey() + "=" + count.getValue() + "\n");
+            }
+        }
+
+        public static Properties readBaseline(Path file) throws IOException {
+            Properties baseline = new Properties();
+            try (Reader reader = Files.newBufferedReader(file, StandardCharsets.ISO_8859_1)) {
+                baseline.load(reader);
+            }
+            return baseline;
+        }
+
+        public void print(PrintStream out, int top) {
+            long tokens = 0;
+            long parseNanos = 0;
+            int syntaxErrors = 0;
+            for (ParseStats.FileStats file : stats.getFiles()) {
+                tokens += file.getTokens();
+                parseNanos += file.getParseNanos();
+                syntaxErrors += file.getSyntaxErrors();
+            }
+            out.println(stats.getFiles().size() + " files, " + tokens + " tokens, " + syntaxErrors
+                    + " syntax errors, " + parseNanos / 1000000 + " ms");
+            out.println(total);
+            out.println("ambiguous decisions:");
+            for (ParseStats.DecisionStats decision : getAmbiguousDecisions())
+                out.println("    " + decision.getDecision() + " (" + decision.getRule() + "): "
+                        + decision.getAmbiguities() + " ambiguities in " + decision.getInvocations() + " predictions");
+            out.println("rules by prediction time:");
+            List<RuleStats> sorted = getRules();
+            for (RuleStats rule : sorted.subList(0, Math.min(top, sorted.size())))
+                out.println("    " + rule);
+        }
+    }
+
+    /**
+     * Decision statistics summed over the decisions of a rule.
+     */
+    public static class RuleStats {
+        private final String rule;
+        long invocations;
+        long timeInPrediction;
+        long llFallback;
+        long contextSensitivities;
+        long ambiguities;
+        long errors;
+
+        RuleStats(String rule) {
+            this.rule = rule;
+        }
+
+        public String getRule() {
+            return rule;
+        }
+
+        public long getInvocations() {
+            return invocations;
+        }
+
+        public long getTimeInPrediction() {
+            return timeInPrediction;
+        }
+
+        public long getLlFallback() {
+            return llFallback;
+        }
+
+        public long getContextSensitivities() {
+            return contextSensitivities;
+        }
+
+        public long getAmbiguities() {
+            return ambiguities;
+        }
+
+        public long getErrors() {
+            return errors;
+        }
+
+        private void add(ParseStats.DecisionStats decision) {
+            invocations += decision.getInvocations();
+            timeInPrediction += decision.getTimeInPrediction();
+            llFallback += decision.getLlFallback();
+            contextSensitivities += decision.getContextSensitivities();
+            ambiguities += decision.getAmbiguities();
+            errors += decision.getErrors();
+        }
+
+        private void addCounts(Map<String, Long> counts, String prefix) {
+            long[] values = { llFallback, contextSensitivities, ambiguities, errors };
+            for (int i = 0; i < COUNTS.length; i++) {
+                if (values[i] > 0)
+                    counts.put(prefix + COUNTS[i], values[i]);
+            }
+        }
+
+        @Override
+        public String toString() {
+            return rule + ": " + invocations + " predictions, " + timeInPrediction / 1000000 + " ms, LL fallbacks: "
+                    + llFallback + ", context sensitivities: " + contextSensitivities + ", ambiguities: "
+                    + ambiguities;
+        }
+    }
+}
@@ -0,0 +1,227 @@
+package com.microsoft.calculator;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Deque;
+import java.util.LinkedHashMap;
+import java.util.LinkedHashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+import com.microsoft.CPPCXLexer;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.Token;
+
+/**
+ * Builds the include graph of a set of translation units from their
+ * {@code #include} directives.
+ *
+ * {@link #resolve} only looks at the directives, collected by a
+ * {@link DirectiveTokenSource}, so a file is lexed but not parsed;
+ * {@link ProjectParser} instead adds the directives its parses collected.
+ * {@code #include "file"} is looked up next to the including file first and
+ * then in the include directories, {@code #include <file>} in the include
+ * directories only. Includes that are not found, such as system headers, are
+ * recorded as unresolved. Conditional compilation is not evaluated, so every
+ * directive counts.
+ *
+ * A resolver reuses one lexer and must not be shared between threads.
+ */
+public class IncludeResolver {
+
+    private final List<Path> includeDirs;
+    private final CPPCXLexer lexer = new CPPCXLexer(CharStreams.fromString(""));
+
+    public IncludeResolver(List<Path> includeDirs) {
+        this.includeDirs = new ArrayList<>(includeDirs);
+        lexer.removeErrorListeners();
+    }
+
+    public List<Path> getIncludeDirs() {
+        return Collections.unmodifiableList(includeDirs);
+    }
+
+    /**
+     * Follows the includes of the translation units transitively. Every
+     * file is read once however often it is included, and include cycles
+     * end at the first file seen again.
+     */
+    public IncludeGraph resolve(List<Path> units) throws IOException {
+        IncludeGraph graph = newGraph(units);
+        Deque<Path> queue = new ArrayDeque<>(graph.getFiles());
+        while (!queue.isEmpty()) {
+            Path file = queue.remove();
+            try {
+                queue.addAll(addIncludes(graph, file, directives(file)));
+            } catch (IOException e) {
+                // Left without includes; parsing the file reports the failure.
+            }
+        }
+        return graph;
+    }
+
+    /**
+     * A graph of the translation units alone, to be completed with
+     * {@link #addIncludes} from directives collected elsewhere, such as
+     * while parsing.
+     */
+    public IncludeGraph newGraph(List<Path> units) throws IOException {
+        IncludeGraph graph = new IncludeGraph();
+        for (Path unit : units) {
+            Path file = canonical(unit);
+            if (graph.add(file))
+                graph.units.add(file);
+        }
+        return graph;
+    }
+
+    /**
+     * Records the includes of a file of the graph given its directives.
+     *
+     * @return the headers that were not in the graph yet, in directive order
+     */
+    public List<Path> addIncludes(IncludeGraph graph, Path file, DirectiveIndex directives) throws IOException {
+        List<Path> found = new ArrayList<>();
+        for (int i = 0; i < directives.size(); i++) {
+            DirectiveIndex.Kind kind = directives.getKind(i);
+            if (kind != DirectiveIndex.Kind.INCLUDE && kind != DirectiveIndex.Kind.SYSTEM_INCLUDE)
+                continue;
+            String name = directives.getName(i);
+            Path header = find(file, name, kind == DirectiveIndex.Kind.INCLUDE);
+            if (header == null) {
+                graph.unresolved.get(file).add(name);
+                continue;
+            }
+            graph.includes.get(file).add(header);
+            if (graph.add(header))
+                found.add(header);
+        }
+        return found;
+    }
+
+    /**
+     * Lexes the file for its directives alone.
+     */
+    public DirectiveIndex directives(Path file) throws IOException {
+        lexer.setInputStream(MappedCharStream.fromPath(file));
+        DirectiveTokenSource source = new DirectiveTokenSource(lexer);
+        while (source.nextToken().getType() != Token.EOF)
+            ;
+        return source.getIndex();
+    }
+
+    private Path find(Path includer, String name, boolean quoted) throws IOException {
+        if (quoted) {
+            Path dir = includer.getParent();
+            Path candidate = dir == null ? null : dir.resolve(name);
+            if (candidate != null && Files.isRegularFile(candidate))
+                return canonical(candidate);
+        }
+        for (Path dir : includeDirs) {
+            Path candidate = dir.resolve(name);
+            if (Files.isRegularFile(candidate))
+                return canonical(candidate);
+        }
+        return null;
+    }
+
+    /**
+     * One path per file, so that a header reached through different
+     * relative paths is read once.
+     */
+    static Path canonical(Path file) throws IOException {
+        return Files.exists(file) ? file.toRealPath() : file.toAbsolutePath().normalize();
+    }
+
+    /**
+     * The files reachable from a set of translation units and which files
+     * each of them includes. All paths are canonical.
+     */
+    public static class IncludeGraph {
+        private final Set<Path> units = new LinkedHashSet<>();
+        private final Map<Path, Set<Path>> includes = new LinkedHashMap<>();
+        private final Map<Path, List<String>> unresolved = new LinkedHashMap<>();
+
+        IncludeGraph() {
+        }
+
+        private boolean add(Path file) {
+            if (includes.containsKey(file))
+                return false;
+            includes.put(file, new LinkedHashSet<Path>());
+            unresolved.put(file, new ArrayList<String>());
+            return true;
+        }
+
+        /**
+         * The translation units, then the headers in the order they were
+         * found.
+         */
+        public List<Path> getFiles() {
+            return new ArrayList<>(includes.keySet());
+        }
+
+        public Set<Path> getUnits() {
+            return Collections.unmodifiableSet(units);
+        }
+
+        /**
+         * The files reached only through includes.
+         */
+        public List<Path> getHeaders() {
+            List<Path> headers = new ArrayList<>();
+            for (Path file : includes.keySet()) {
+                if (!units.contains(file))
+                    headers.add(file);
+            }
+            return headers;
+        }
+
+        /**
+         * The files a file includes directly, in directive order.
+         */
+        public Set<Path> getIncludes(Path file) {
+            Set<Path> direct = includes.get(file);
+            return direct == null ? Collections.<Path>emptySet() : Collections.unmodifiableSet(direct);
+        }
+
+        /**
+         * The include names of a file that were not found.
+         */
+        public List<String> getUnresolved(Path file) {
+            List<String> names = unresolved.get(file);
+            return names == null ? Collections.<String>emptyList() : Collections.unmodifiableList(names);
+        }
+
+        public int getUnresolvedCount() {
+            int count = 0;
+            for (List<String> names : unresolved.values())
+                count += names.size();
+            return count;
+        }
+
+        /**
+         * All files a file includes directly or indirectly, depth first in
+         * directive order, without the file itself.
+         */
+        public Set<Path> transitiveIncludes(Path file) {
+            Set<Path> seen = new LinkedHashSet<>();
+            collect(file, seen);
+            seen.remove(file);
+            return seen;
+        }
+
+        private void collect(Path file, Set<Path> seen) {
+            for (Path header : getIncludes(file)) {
+                if (seen.add(header))
+                    collect(header, seen);
+            }
+        }
+    }
+}
@@ -0,0 +1,288 @@
+package com.microsoft.calculator;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+import com.microsoft.CPPCXParser.DeclarationContext;
+import com.microsoft.CPPCXParser.MemberdeclarationContext;
+import com.microsoft.CPPCXParser.TranslationUnitContext;
+
+import org.antlr.v4.runtime.BaseErrorListener;
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonToken;
+import org.antlr.v4.runtime.CommonTokenFactory;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.ListTokenSource;
+import org.antlr.v4.runtime.ParserRuleContext;
+import org.antlr.v4.runtime.RecognitionException;
+import org.antlr.v4.runtime.Recognizer;
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.tree.ParseTree;
+
+/**
+ * Keeps the parse tree of one document up to date as it is edited.
+ *
+ * An edit is applied by re-lexing only the innermost {@code declaration} or
+ * {@code memberdeclaration} that contains it and parsing that rule on its
+ * own. The new subtree replaces the old one in place; the tokens after it are
+ * shifted and renumbered, so the rest of the tree stays valid. Whenever the
+ * edit cannot be confined this way (it spans several declarations, the
+ * region no longer lexes or parses as one rule, or the document already has
+ * syntax errors) the whole document is re-parsed.
+ *
+ * Offsets are code point indexes, the same as {@link Token#getStartIndex()}.
+ * Tokens carry their own text, since those from different versions of the
+ * document end up in the same tree.
+ */
+public class IncrementalParser {
+
+    private static final CommonTokenFactory TOKEN_FACTORY = new CommonTokenFactory(true);
+
+    private final TwoStageParser twoStage;
+    private final String sourceName;
+    private String text;
+    private List<Token> tokens;
+    private TranslationUnitContext tree;
+    private int syntaxErrors;
+    private long fullParseCount;
+    private long incrementalParseCount;
+
+    public IncrementalParser(String text, String sourceName) {
+        this(text, sourceName, new TwoStageParser());
+    }
+
+    public IncrementalParser(String text, String sourceName, TwoStageParser twoStage) {
+        this.twoStage = twoStage;
+        this.sourceName = sourceName;
+        parseFully(text);
+    }
+
+    public String getText() {
+        return text;
+    }
+
+    public TranslationUnitContext getTree() {
+        return tree;
+    }
+
+    /**
+     * All tokens of the current text including hidden ones and EOF.
+     */
+    public List<Token> getTokens() {
+        return Collections.unmodifiableList(tokens);
+    }
+
+    public int getSyntaxErrorCount() {
+        return syntaxErrors;
+    }
+
+    public long getFullParseCount() {
+        return fullParseCount;
+    }
+
+    public long getIncrementalParseCount() {
+        return incrementalParseCount;
+    }
+
+    /**
+     * Replaces the code points {@code [start, end)} with the replacement and
+     * updates the tree.
+     *
+     * @return the subtree that was re-parsed, which is the whole tree after a
+     *         full parse
+     */
+    public ParserRuleContext edit(int start, int end, String replacement) {
+        int from = text.offsetByCodePoints(0, start);
+        int to = text.offsetByCodePoints(from, end - start);
+        String newText = text.substring(0, from) + replacement + text.substring(to);
+
+        ParserRuleContext node = syntaxErrors == 0 ? enclosingDeclaration(tree, start, end) : null;
+        ParserRuleContext replaced = node == null ? null
+                : reparse(node, newText, replacement.codePointCount(0, replacement.length()) - (end - start));
+        if (replaced != null) {
+            text = newText;
+            incrementalParseCount++;
+            return replaced;
+        }
+        parseFully(newText);
+        return tree;
+    }
+
+    private void parseFully(String newText) {
+        CPPCXLexer lexer = new CPPCXLexer(CharStreams.fromString(newText, sourceName));
+        lexer.setTokenFactory(TOKEN_FACTORY);
+        ErrorCounter lexerErrors = new ErrorCounter();
+        lexer.addErrorListener(lexerErrors);
+        CommonTokenStream stream = new CommonTokenStream(lexer);
+        CPPCXParser parser = new CPPCXParser(stream);
+        tree = twoStage.parse(parser);
+        stream.fill();
+        text = newText;
+        tokens = new ArrayList<>(stream.getTokens());
+        syntaxErrors = lexerErrors.count + parser.getNumberOfSyntaxErrors();
+        fullParseCount++;
+    }
+
+    /**
+     * The innermost declaration or member declaration whose text contains
+     * {@code [start, end)}, or null.
+     *
+     * An edit may touch the first or last character of the declaration only
+     * if whitespace separates it from its neighbours, otherwise the tokens on
+     * either side could merge with it.
+     */
+    private ParserRuleContext enclosingDeclaration(ParserRuleContext ctx, int start, int end) {
+        ParserRuleContext found = null;
+        while (true) {
+            ParserRuleContext next = null;
+            for (int i = 0; i < ctx.getChildCount(); i++) {
+                ParseTree child = ctx.getChild(i);
+                if (child instanceof ParserRuleContext && contains((ParserRuleContext) child, start, end)) {
+                    next = (ParserRuleContext) child;
+                    break;
+                }
+            }
+            if (next == null)
+                return found;
+            if (next instanceof DeclarationContext || next instanceof MemberdeclarationContext)
+                found = next;
+            ctx = next;
+        }
+    }
+
+    private boolean contains(ParserRuleContext ctx, int start, int end) {
+        if (ctx.getStart() == null || ctx.getStop() == null || ctx.getStop().getType() == Token.EOF
+                || ctx.getStop().getTokenIndex() < ctx.getStart().getTokenIndex())
+            return false;
+        int first = ctx.getStart().getStartIndex();
+        int last = ctx.getStop().getStopIndex();
+        if (start < first || end > last + 1)
+            return false;
+        if (start == first && first > 0 && !isWhitespace(first - 1))
+            return false;
+        return end <= last || isWhitespace(last + 1);
+    }
+
+    private boolean isWhitespace(int codePointIndex) {
+        int index = text.offsetByCodePoints(0, codePointIndex);
+        return index >= text.length() || Character.isWhitespace(text.codePointAt(index));
+    }
+
+    /**
+     * Re-lexes and re-parses the node's region of the new text and splices
+     * the result into the tree, or returns null if that is not possible.
+     */
+    private ParserRuleContext reparse(ParserRuleContext node, String newText, int delta) {
+        Token oldStart = node.getStart();
+        Token oldStop = node.getStop();
+        int regionStart = oldStart.getStartIndex();
+        int regionStop = oldStop.getStopIndex() + delta;
+        if (regionStop < regionStart)
+            return null;
+
+        List<Token> region = lex(newText, oldStart, regionStop);
+        if (region == null)
+            return null;
+
+        CommonTokenStream stream = new CommonTokenStream(new ListTokenSource(region, sourceName));
+        CPPCXParser parser = new CPPCXParser(stream);
+        parser.removeErrorListeners();
+        ParserRuleContext replacement = node instanceof DeclarationContext
+                ? twoStage.parse(parser, TwoStageParser.DECLARATION)
+                : twoStage.parse(parser, TwoStageParser.MEMBER_DECLARATION);
+        if (parser.getNumberOfSyntaxErrors() > 0 || stream.LA(1) != Token.EOF || replacement.getStop() == null
+                || replacement.getStop().getStopIndex() != regionStop)
+            return null;
+
+        splice(node, replacement, region, delta);
+        return replacement;
+    }
+
+    /**
+     * Lexes the new text from the start of the old node up to and including
+     * {@code regionStop}, which must be the end of a token.
+     */
+    private List<Token> lex(String newText, Token oldStart, int regionStop) {
+        CharStream input = CharStreams.fromString(newText, sourceName);
+        input.seek(oldStart.getStartIndex());
+        CPPCXLexer lexer = new CPPCXLexer(input);
+        lexer.setTokenFactory(TOKEN_FACTORY);
+        lexer.setLine(oldStart.getLine());
+        lexer.setCharPositionInLine(oldStart.getCharPositionInLine());
+        ErrorCounter lexerErrors = new ErrorCounter();
+        lexer.removeErrorListeners();
+        lexer.addErrorListener(lexerErrors);
+
+        List<Token> region = new ArrayList<>();
+        while (true) {
+            Token token = lexer.nextToken();
+            if (token.getType() == Token.EOF || token.getStopIndex() > regionStop || lexerErrors.count > 0)
+                return null;
+            region.add(token);
+            if (token.getStopIndex() == regionStop)
+                return region;
+        }
+    }
+
+    private void splice(ParserRuleContext node, ParserRuleContext replacement, List<Token> region, int delta) {
+        Token oldStart = node.getStart();
+        Token oldStop = node.getStop();
+        Token newStop = region.get(region.size() - 1);
+        int first = oldStart.getTokenIndex();
+        int last = oldStop.getTokenIndex();
+
+        for (int i = 0; i < region.size(); i++)
+            ((CommonToken) region.get(i)).setTokenIndex(first + i);
+
+        // Shift what follows. Only tokens on the node's last line move sideways.
+        int indexDelta = region.size() - (last - first + 1);
+        int lineDelta = newStop.getLine() - oldStop.getLine();
+        int columnDelta = endColumn(newStop) - endColumn(oldStop);
+        for (int i = last + 1; i < tokens.size(); i++) {
+            CommonToken token = (CommonToken) tokens.get(i);
+            if (token.getLine() == oldStop.getLine())
+                token.setCharPositionInLine(token.getCharPositionInLine() + columnDelta);
+            token.setLine(token.getLine() + lineDelta);
+            token.setStartIndex(token.getStartIndex() + delta);
+            token.setStopIndex(token.getStopIndex() + delta);
+            token.setTokenIndex(token.getTokenIndex() + indexDelta);
+        }
+        List<Token> suffix = new ArrayList<>(tokens.subList(last + 1, tokens.size()));
+        tokens.subList(first, tokens.size()).clear();
+        tokens.addAll(region);
+        tokens.addAll(suffix);
+
+        ParserRuleContext parent = node.getParent();
+        parent.children.set(parent.children.indexOf(node), replacement);
+        replacement.setParent(parent);
+        replacement.invokingState = node.invokingState;
+        for (ParserRuleContext ancestor = parent; ancestor != null; ancestor = ancestor.getParent()) {
+            if (ancestor.start == oldStart)
+                ancestor.start = replacement.getStart();
+            if (ancestor.stop == oldStop)
+                ancestor.stop = replacement.getStop();
+        }
+    }
+
+    /**
+     * Column just after a token. Declarations end in a single-line token such
+     * as {@code ;} or a closing brace.
+     */
+    private static int endColumn(Token token) {
+        return token.getCharPositionInLine() + token.getStopIndex() - token.getStartIndex() + 1;
+    }
+
+    private static class ErrorCounter extends BaseErrorListener {
+        int count;
+
+        @Override
+        public void syntaxError(Recognizer<?, ?> recognizer, Object offendingSymbol, int line,
+                int charPositionInLine, String msg, RecognitionException e) {
+            count++;
+        }
+    }
+}
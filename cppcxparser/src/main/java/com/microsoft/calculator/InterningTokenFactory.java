@@ -0,0 +1,191 @@
+package com.microsoft.calculator;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentMap;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.TokenFactory;
+import org.antlr.v4.runtime.TokenSource;
+import org.antlr.v4.runtime.misc.Interval;
+import org.antlr.v4.runtime.misc.Pair;
+
+/**
+ * A token factory for parsing many files in turn that keeps neither token
+ * texts nor tokens per file.
+ *
+ * The text of every default channel token up to {@value #MAX_INTERNED_LENGTH}
+ * characters, that is of identifiers, keywords, operators and short
+ * literals, is copied once into a {@link TextTable} shared by all factories,
+ * so the thousands of {@code Platform} and {@code String} tokens of a corpus
+ * share one string each. Other tokens read their text from the input as
+ * with {@link org.antlr.v4.runtime.CommonTokenFactory#DEFAULT}.
+ *
+ * Tokens come from a pool that {@link #reset} recycles, which must only be
+ * called once nothing refers to the tokens of the previous file any more:
+ * neither a token stream nor a parse tree. The pool grows to the token count
+ * of the largest file. Not safe to share between threads; the text table
+ * is.
+ */
+public class InterningTokenFactory implements TokenFactory<PooledToken> {
+
+    static final int MAX_INTERNED_LENGTH = 64;
+
+    private final TextTable texts;
+    private final List<PooledToken> pool = new ArrayList<>();
+    private int used;
+    private final Counts counts = new Counts();
+
+    public InterningTokenFactory(TextTable texts) {
+        this.texts = texts;
+    }
+
+    /**
+     * Makes all tokens handed out so far available again.
+     */
+    public void reset() {
+        used = 0;
+    }
+
+    /**
+     * Detaches the tokens handed out since {@link #reset} from their input,
+     * so that the pool does not keep the previous file alive until the
+     * next one. The tokens must not be used any more.
+     */
+    public void release() {
+        for (int i = 0; i < used; i++)
+            pool.get(i).reset(Token.INVALID_TYPE, null);
+    }
+
+    /**
+     * What this factory did so far.
+     */
+    public Counts getCounts() {
+        return counts;
+    }
+
+    @Override
+    public PooledToken create(Pair<TokenSource, CharStream> source, int type, String text, int channel, int start,
+            int stop, int line, int charPositionInLine) {
+        if (text == null && type != Token.EOF && channel == Token.DEFAULT_CHANNEL && source.b != null
+                && stop - start < MAX_INTERNED_LENGTH) {
+            String copy = source.b.getText(Interval.of(start, stop));
+            text = texts.intern(copy);
+            if (text == copy)
+                counts.internMisses++;
+            else
+                counts.internHits++;
+        }
+        PooledToken token = take();
+        token.reset(source, type, text, channel, start, stop, line, charPositionInLine);
+        return token;
+    }
+
+    @Override
+    public PooledToken create(int type, String text) {
+        PooledToken token = take();
+        token.reset(type, text);
+        return token;
+    }
+
+    private PooledToken take() {
+        if (used < pool.size()) {
+            counts.reused++;
+            return pool.get(used++);
+        }
+        counts.created++;
+        PooledToken token = new PooledToken();
+        pool.add(token);
+        used++;
+        return token;
+    }
+
+    /**
+     * The interned texts, shared between factories and threads. Once full
+     * it keeps the texts it has and returns new ones as given.
+     */
+    public static class TextTable {
+        private static final int DEFAULT_CAPACITY = 1 << 20;
+
+        private final ConcurrentMap<String, String> texts = new ConcurrentHashMap<>();
+        private final int capacity;
+
+        public TextTable() {
+            this(DEFAULT_CAPACITY);
+        }
+
+        public TextTable(int capacity) {
+            this.capacity = capacity;
+        }
+
+        /**
+         * The text in the table equal to the given one, which is added if
+         * there is none.
+         */
+        public String intern(String text) {
+            String interned = texts.get(text);
+            if (interned != null)
+                return interned;
+            if (texts.size() >= capacity)
+                return text;
+            interned = texts.putIfAbsent(text, text);
+            return interned != null ? interned : text;
+        }
+
+        public int size() {
+            return texts.size();
+        }
+    }
+
+    /**
+     * Token and text counters of one or more factories.
+     */
+    public static class Counts {
+        private long created;
+        private long reused;
+        private long internHits;
+        private long internMisses;
+
+        public long getCreated() {
+            return created;
+        }
+
+        public long getReused() {
+            return reused;
+        }
+
+        /**
+         * Texts that were already in the table, so only a temporary copy was
+         * made.
+         */
+        public long getInternHits() {
+            return internHits;
+        }
+
+        public long getInternMisses() {
+            return internMisses;
+        }
+
+        public void add(Counts other) {
+            created += other.created;
+            reused += other.reused;
+            internHits += other.internHits;
+            internMisses += other.internMisses;
+        }
+
+        void clear() {
+            created = 0;
+            reused = 0;
+            internHits = 0;
+            internMisses = 0;
+        }
+
+        @Override
+        public String toString() {
+            return "tokens created: " + created + ", reused: " + reused + ", intern hits: " + internHits
+                    + ", misses: " + internMisses;
+        }
+    }
+}
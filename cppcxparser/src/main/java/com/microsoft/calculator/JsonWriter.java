@@ -0,0 +1,148 @@
+package com.microsoft.calculator;
+
+import java.io.IOException;
+import java.io.Writer;
+import java.util.ArrayDeque;
+import java.util.Deque;
+import java.util.Locale;
+
+/**
+ * Writes JSON to a {@link Writer}, one array or object member per line.
+ *
+ * Only as much as the reports need: nesting, names, strings, numbers and
+ * booleans. Calls are not validated beyond comma placement.
+ */
+public class JsonWriter {
+
+    private final Writer out;
+    /** Whether the innermost open array or object already has a member. */
+    private final Deque<Boolean> nonEmpty = new ArrayDeque<>();
+    private boolean afterName;
+
+    public JsonWriter(Writer out) {
+        this.out = out;
+    }
+
+    public JsonWriter beginObject() throws IOException {
+        return open('{');
+    }
+
+    public JsonWriter endObject() throws IOException {
+        return close('}');
+    }
+
+    public JsonWriter beginArray() throws IOException {
+        return open('[');
+    }
+
+    public JsonWriter endArray() throws IOException {
+        return close(']');
+    }
+
+    public JsonWriter name(String name) throws IOException {
+        separate();
+        string(name);
+        out.write(": ");
+        afterName = true;
+        return this;
+    }
+
+    public JsonWriter value(String value) throws IOException {
+        separate();
+        if (value == null)
+            out.write("null");
+        else
+            string(value);
+        return this;
+    }
+
+    public JsonWriter value(long value) throws IOException {
+        separate();
+        out.write(Long.toString(value));
+        return this;
+    }
+
+    /**
+     * Writes the value with three decimals, enough for milliseconds.
+     */
+    public JsonWriter value(double value) throws IOException {
+        separate();
+        out.write(String.format(Locale.ROOT, "%.3f", value));
+        return this;
+    }
+
+    public JsonWriter value(boolean value) throws IOException {
+        separate();
+        out.write(value ? "true" : "false");
+        return this;
+    }
+
+    public void flush() throws IOException {
+        out.flush();
+    }
+
+    private JsonWriter open(char c) throws IOException {
+        separate();
+        out.write(c);
+        nonEmpty.push(false);
+        return this;
+    }
+
+    private JsonWriter close(char c) throws IOException {
+        if (nonEmpty.pop())
+            newline();
+        out.write(c);
+        if (nonEmpty.isEmpty())
+            out.write('\n');
+        return this;
+    }
+
+    private void separate() throws IOException {
+        if (afterName) {
+            afterName = false;
+            return;
+        }
+        if (nonEmpty.isEmpty())
+            return;
+        if (nonEmpty.pop())
+            out.write(',');
+        nonEmpty.push(true);
+        newline();
+    }
+
+    private void newline() throws IOException {
+        out.write('\n');
+        for (int i = 0; i < nonEmpty.size(); i++)
+            out.write("  ");
+    }
+
+    private void string(String s) throws IOException {
+        out.write('"');
+        for (int i = 0; i < s.length(); i++) {
+            char c = s.charAt(i);
+            switch (c) {
+            case '"':
+                out.write("\\\"");
+                break;
+            case '\\':
+                out.write("\\\\");
+                break;
+            case '\n':
+                out.write("\\n");
+                break;
+            case '\r':
+                out.write("\\r");
+                break;
+            case '\t':
+                out.write("\\t");
+                break;
+            default:
+                if (c < 0x20)
+                    out.write(String.format(Locale.ROOT, "\\u%04x", (int) c));
+                else
+                    out.write(c);
+            }
+        }
+        out.write('"');
+    }
+}
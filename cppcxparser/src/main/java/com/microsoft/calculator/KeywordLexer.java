@@ -0,0 +1,31 @@
+package com.microsoft.calculator;
+
+import com.microsoft.CPPCXFastLexer;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.Token;
+
+/**
+ * A lexer that produces the same tokens as {@link com.microsoft.CPPCXLexer}
+ * with a smaller DFA.
+ *
+ * {@link CPPCXFastLexer} has no keyword rules and lexes keywords as
+ * identifiers; every identifier is looked up in the {@link KeywordTable}
+ * before its token is created. The character stream must be able to look
+ * back over the current token, which {@link CharStream}s from
+ * {@link org.antlr.v4.runtime.CharStreams} and {@link MappedCharStream} can
+ * but an {@link org.antlr.v4.runtime.UnbufferedCharStream} cannot.
+ */
+public class KeywordLexer extends CPPCXFastLexer {
+
+    public KeywordLexer(CharStream input) {
+        super(input);
+    }
+
+    @Override
+    public Token emit() {
+        if (_type == Identifier)
+            _type = KeywordTable.type(_input, _tokenStartCharIndex, getCharIndex() - 1);
+        return super.emit();
+    }
+}
@@ -0,0 +1,148 @@
+package com.microsoft.calculator;
+
+import java.util.Arrays;
+import java.util.LinkedHashMap;
+import java.util.Map;
+
+import com.microsoft.CPPCXLexer;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.Vocabulary;
+
+/**
+ * The token types of the {@link CPPCXLexer} keywords by text, in a perfect
+ * hash table.
+ *
+ * The keywords are the literal tokens of the lexer's vocabulary that look
+ * like identifiers, so the table follows the grammar. {@code true},
+ * {@code false} and {@code nullptr} map to {@code BooleanLiteral} and
+ * {@code PointerLiteral}, which the lexer matches before the keyword rules
+ * of the same text. The hash seed is searched for when the class loads, so
+ * that every keyword has a slot of its own and a lookup reads each
+ * character of the identifier once for the hash and once for the compare.
+ */
+public final class KeywordTable {
+
+    private static final int MAX_LENGTH;
+    private static final int MASK;
+    private static final int SEED;
+    private static final char[][] TEXTS;
+    private static final int[] TYPES;
+
+    static {
+        Map<String, Integer> keywords = keywords(CPPCXLexer.VOCABULARY);
+        int maxLength = 0;
+        for (String text : keywords.keySet())
+            maxLength = Math.max(maxLength, text.length());
+        MAX_LENGTH = maxLength;
+        int size = Integer.highestOneBit(keywords.size()) * 16;
+        MASK = size - 1;
+        TEXTS = new char[size][];
+        TYPES = new int[size];
+        SEED = findSeed(keywords, size);
+        for (Map.Entry<String, Integer> keyword : keywords.entrySet()) {
+            int slot = slot(hash(SEED, keyword.getKey()));
+            TEXTS[slot] = keyword.getKey().toCharArray();
+            TYPES[slot] = keyword.getValue();
+        }
+    }
+
+    private KeywordTable() {
+    }
+
+    /**
+     * The type of the identifier from {@code start} to {@code stop}, which
+     * the input has just passed, or {@link CPPCXLexer#Identifier} if it is
+     * no keyword. The input must be able to look back over the identifier.
+     */
+    public static int type(CharStream input, int start, int stop) {
+        int length = stop - start + 1;
+        if (length > MAX_LENGTH)
+            return CPPCXLexer.Identifier;
+        // LA(-n) is the nth character before the index.
+        int back = start - input.index();
+        int h = SEED;
+        for (int i = 0; i < length; i++)
+            h = mix(h, input.LA(back + i));
+        int slot = slot(h);
+        char[] text = TEXTS[slot];
+        if (text == null || text.length != length)
+            return CPPCXLexer.Identifier;
+        for (int i = 0; i < length; i++) {
+            if (input.LA(back + i) != text[i])
+                return CPPCXLexer.Identifier;
+        }
+        return TYPES[slot];
+    }
+
+    /**
+     * The type of the text if it is a keyword, or
+     * {@link CPPCXLexer#Identifier}.
+     */
+    public static int type(String text) {
+        if (text.length() > MAX_LENGTH)
+            return CPPCXLexer.Identifier;
+        int slot = slot(hash(SEED, text));
+        return TEXTS[slot] != null && String.valueOf(TEXTS[slot]).equals(text) ? TYPES[slot]
+                : CPPCXLexer.Identifier;
+    }
+
+    static int size() {
+        int size = 0;
+        for (char[] text : TEXTS) {
+            if (text != null)
+                size++;
+        }
+        return size;
+    }
+
+    static Map<String, Integer> keywords(Vocabulary vocabulary) {
+        Map<String, Integer> keywords = new LinkedHashMap<>();
+        for (int type = 1; type <= vocabulary.getMaxTokenType(); type++) {
+            String literal = vocabulary.getLiteralName(type);
+            if (literal == null || !literal.matches("'[A-Za-z_][A-Za-z0-9_]*'"))
+                continue;
+            String text = literal.substring(1, literal.length() - 1);
+            if (!keywords.containsKey(text))
+                keywords.put(text, type);
+        }
+        keywords.put("true", CPPCXLexer.BooleanLiteral);
+        keywords.put("false", CPPCXLexer.BooleanLiteral);
+        keywords.put("nullptr", CPPCXLexer.PointerLiteral);
+        return keywords;
+    }
+
+    private static int findSeed(Map<String, Integer> keywords, int size) {
+        boolean[] used = new boolean[size];
+        for (int seed = 0x811c9dc5, tries = 0; tries < 1 << 20; seed += 2, tries++) {
+            Arrays.fill(used, false);
+            boolean collision = false;
+            for (String text : keywords.keySet()) {
+                int slot = slot(hash(seed, text));
+                if (used[slot]) {
+                    collision = true;
+                    break;
+                }
+                used[slot] = true;
+            }
+            if (!collision)
+                return seed;
+        }
+        throw new IllegalStateException("no perfect hash for " + keywords.size() + " keywords");
+    }
+
+    private static int hash(int seed, String text) {
+        int h = seed;
+        for (int i = 0; i < text.length(); i++)
+            h = mix(h, text.charAt(i));
+        return h;
+    }
+
+    private static int mix(int h, int c) {
+        return (h ^ c) * 0x01000193;
+    }
+
+    private static int slot(int h) {
+        return (h ^ h >>> 15) & MASK;
+    }
+}
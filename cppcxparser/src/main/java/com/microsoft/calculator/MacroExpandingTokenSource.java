@@ -0,0 +1,201 @@
+package com.microsoft.calculator;
+
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Deque;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+
+import com.microsoft.CPPCXLexer;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.CommonToken;
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.TokenFactory;
+import org.antlr.v4.runtime.TokenSource;
+import org.antlr.v4.runtime.misc.Pair;
+
+/**
+ * Replaces invocations of the macros in a {@link MacroTable} by their
+ * expansions between the lexer and the parser.
+ *
+ * Expansions are rescanned for further invocations. Every expanded token
+ * carries a hide set, the names of the macros it came from, which are not
+ * expanded again, so recursive macros terminate as in the C preprocessor.
+ * Arguments are substituted as written rather than expanded first. Expanded
+ * tokens take their position from the macro name of the invocation, so
+ * syntax errors inside an expansion point at the invocation.
+ *
+ * A function-like macro name that is not followed by an argument list, or
+ * whose argument list is not closed before EOF, is passed through unchanged.
+ * The {@code #define} directives of the input are not added to the table,
+ * which is shared by all files.
+ */
+public class MacroExpandingTokenSource implements TokenSource {
+
+    private final TokenSource source;
+    private final MacroTable macros;
+    /** Tokens read from the source or produced by expansion but not yet examined. */
+    private final Deque<Token> pending = new ArrayDeque<>();
+    private int expansionCount;
+
+    public MacroExpandingTokenSource(TokenSource source, MacroTable macros) {
+        this.source = source;
+        this.macros = macros;
+    }
+
+    /**
+     * Number of macro invocations expanded so far, nested ones included.
+     */
+    public int getExpansionCount() {
+        return expansionCount;
+    }
+
+    @Override
+    public Token nextToken() {
+        while (true) {
+            Token token = take();
+            if (token.getChannel() != Token.DEFAULT_CHANNEL || token.getType() != CPPCXLexer.Identifier)
+                return token;
+            MacroTable.Macro macro = macros.get(token.getText());
+            if (macro == null || hideSet(token).contains(macro.getName()) || !expand(token, macro))
+                return token;
+        }
+    }
+
+    /**
+     * Pushes the expansion of an invocation starting at the macro name,
+     * or returns false if this is not an invocation.
+     */
+    private boolean expand(Token name, MacroTable.Macro macro) {
+        List<List<Token>> args = new ArrayList<>();
+        if (macro.isFunctionLike() && !readArgs(macro, args))
+            return false;
+
+        Set<String> hideSet = new HashSet<>(hideSet(name));
+        hideSet.add(macro.getName());
+        List<Token> expansion = macros.expand(macro, args);
+        for (int i = expansion.size() - 1; i >= 0; i--)
+            pending.push(new ExpandedToken(name, expansion.get(i), hideSet));
+        expansionCount++;
+        return true;
+    }
+
+    /**
+     * Reads a parenthesized argument list, split at top-level commas. If
+     * there is none, puts back what was read and returns false.
+     */
+    private boolean readArgs(MacroTable.Macro macro, List<List<Token>> args) {
+        List<Token> read = new ArrayList<>();
+        Token token = take();
+        read.add(token);
+        while (token.getChannel() != Token.DEFAULT_CHANNEL) {
+            token = take();
+            read.add(token);
+        }
+        if (token.getType() != CPPCXLexer.LeftParen) {
+            putBack(read);
+            return false;
+        }
+
+        int lastParam = macro.getParams().size() - 1;
+        List<Token> arg = new ArrayList<>();
+        int depth = 1;
+        while (true) {
+            token = take();
+            read.add(token);
+            if (token.getType() == Token.EOF) {
+                putBack(read);
+                return false;
+            }
+            if (token.getChannel() != Token.DEFAULT_CHANNEL)
+                continue;
+            int type = token.getType();
+            if (type == CPPCXLexer.LeftParen) {
+                depth++;
+            } else if (type == CPPCXLexer.RightParen && --depth == 0) {
+                if (!arg.isEmpty() || !args.isEmpty() || lastParam >= 0)
+                    args.add(arg);
+                return true;
+            } else if (type == CPPCXLexer.Comma && depth == 1
+                    && !(macro.isVariadic() && args.size() == lastParam)) {
+                args.add(arg);
+                arg = new ArrayList<>();
+                continue;
+            }
+            arg.add(token);
+        }
+    }
+
+    private Token take() {
+        return pending.isEmpty() ? source.nextToken() : pending.pop();
+    }
+
+    private void putBack(List<Token> tokens) {
+        for (int i = tokens.size() - 1; i >= 0; i--)
+            pending.push(tokens.get(i));
+    }
+
+    private static Set<String> hideSet(Token token) {
+        return token instanceof ExpandedToken ? ((ExpandedToken) token).getHideSet()
+                : Collections.<String>emptySet();
+    }
+
+    @Override
+    public int getLine() {
+        return source.getLine();
+    }
+
+    @Override
+    public int getCharPositionInLine() {
+        return source.getCharPositionInLine();
+    }
+
+    @Override
+    public CharStream getInputStream() {
+        return source.getInputStream();
+    }
+
+    @Override
+    public String getSourceName() {
+        return source.getSourceName();
+    }
+
+    @Override
+    public void setTokenFactory(TokenFactory<?> factory) {
+        source.setTokenFactory(factory);
+    }
+
+    @Override
+    public TokenFactory<?> getTokenFactory() {
+        return source.getTokenFactory();
+    }
+
+    /**
+     * A token produced by macro expansion.
+     */
+    public static class ExpandedToken extends CommonToken {
+        private static final long serialVersionUID = 1L;
+
+        private final Set<String> hideSet;
+
+        ExpandedToken(Token invocation, Token replacement, Set<String> hideSet) {
+            super(new Pair<TokenSource, CharStream>(invocation.getTokenSource(), invocation.getInputStream()),
+                    replacement.getType(), Token.DEFAULT_CHANNEL, invocation.getStartIndex(),
+                    invocation.getStopIndex());
+            setText(replacement.getText());
+            setLine(invocation.getLine());
+            setCharPositionInLine(invocation.getCharPositionInLine());
+            this.hideSet = Collections.unmodifiableSet(hideSet);
+        }
+
+        /**
+         * Names of the macros whose expansion produced this token.
+         */
+        public Set<String> getHideSet() {
+            return hideSet;
+        }
+    }
+}
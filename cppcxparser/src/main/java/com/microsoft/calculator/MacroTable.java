@@ -0,0 +1,325 @@
+package com.microsoft.calculator;
+
+import java.io.BufferedReader;
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicLong;
+
+import com.microsoft.CPPCXLexer;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonToken;
+import org.antlr.v4.runtime.Token;
+
+/**
+ * Macro definitions for {@link MacroExpandingTokenSource}, and a cache of
+ * their expansions.
+ *
+ * Definitions are written as in a {@code #define} directive, with or without
+ * the {@code #define} itself. Function-like macros support {@code ##} token
+ * pasting, {@code #} stringizing and {@code __VA_ARGS__}. Conditional
+ * compilation is not evaluated, so only macros whose expansion does not
+ * depend on the configuration should be defined.
+ *
+ * {@link #calculatorDefaults()} defines the property macros of the
+ * Calculator sources. Their expansions are reduced to what the grammar
+ * accepts and the API model needs: the property with its getter, and the
+ * backing field. Safe to share between threads.
+ */
+public class MacroTable {
+
+    static final String PASTE = "__cx_paste__";
+    static final String STRINGIZE = "__cx_stringize__";
+
+    private static final String VA_ARGS = "__VA_ARGS__";
+    private static final int CACHE_SIZE = 4096;
+
+    private final Map<String, Macro> macros = new ConcurrentHashMap<>();
+    private final Map<String, List<Token>> cache = new LinkedHashMap<String, List<Token>>(16, 0.75f, true) {
+        private static final long serialVersionUID = 1L;
+
+        @Override
+        protected boolean removeEldestEntry(Map.Entry<String, List<Token>> eldest) {
+            return size() > CACHE_SIZE;
+        }
+    };
+    private final AtomicLong cacheHits = new AtomicLong();
+    private final AtomicLong cacheMisses = new AtomicLong();
+
+    /**
+     * The macros that declare properties and change notification in the
+     * Calculator sources.
+     */
+    public static MacroTable calculatorDefaults() {
+        MacroTable table = new MacroTable();
+        String getter = "property t n { t get() { return m_##n; } } private: t m_##n; public:";
+        String accessors = "property t n { t get() { return m_##n; } void set(t value) { m_##n = value; } } "
+                + "private: t m_##n; public:";
+        table.define("OBSERVABLE_OBJECT() virtual event Windows::UI::Xaml::Data::PropertyChangedEventHandler ^ "
+                + "PropertyChanged;");
+        table.define("PROPERTY_R(t, n) " + getter);
+        table.define("PROPERTY_RW(t, n) " + accessors);
+        table.define("OBSERVABLE_PROPERTY_R(t, n) " + getter);
+        table.define("OBSERVABLE_PROPERTY_RW(t, n) " + accessors);
+        return table;
+    }
+
+    /**
+     * Defines or redefines a macro, e.g. {@code "MAX(a, b) ((a) > (b) ? (a) : (b))"}.
+     */
+    public void define(String definition) {
+        String s = definition.replaceAll("\\\\\\r?\\n", " ").trim();
+        if (s.startsWith("#")) {
+            s = s.substring(1).trim();
+            if (!s.startsWith("define"))
+                throw new IllegalArgumentException("not a #define: " + definition);
+            s = s.substring("define".length()).trim();
+        }
+
+        int nameEnd = 0;
+        while (nameEnd < s.length() && (Character.isLetterOrDigit(s.charAt(nameEnd)) || s.charAt(nameEnd) == '_'))
+            nameEnd++;
+        if (nameEnd == 0)
+            throw new IllegalArgumentException("missing macro name: " + definition);
+        String name = s.substring(0, nameEnd);
+
+        List<String> params = null;
+        String body = s.substring(nameEnd);
+        if (body.startsWith("(")) {
+            int close = body.indexOf(')');
+            if (close < 0)
+                throw new IllegalArgumentException("missing ')' in macro parameters: " + definition);
+            params = new ArrayList<>();
+            for (String param : body.substring(1, close).split(",")) {
+                param = param.trim();
+                if (param.equals("..."))
+                    param = VA_ARGS;
+                if (!param.isEmpty())
+                    params.add(param);
+            }
+            body = body.substring(close + 1);
+        }
+
+        // # and ## would lex as a directive, so they become marker identifiers.
+        body = body.replace("##", " " + PASTE + " ");
+        if (params != null)
+            body = body.replaceAll("#\\s*(?=[A-Za-z_])", " " + STRINGIZE + " ");
+        macros.put(name, new Macro(name, params, lex(body), s));
+        clearCache();
+    }
+
+    /**
+     * Reads one definition per {@code #define} line, continuation lines
+     * included, and ignores all other lines.
+     */
+    public void defineAll(Path file) throws IOException {
+        try (BufferedReader reader = Files.newBufferedReader(file, StandardCharsets.UTF_8)) {
+            StringBuilder definition = null;
+            for (String line; (line = reader.readLine()) != null;) {
+                if (definition == null) {
+                    String trimmed = line.trim();
+                    if (!trimmed.startsWith("#") || !trimmed.substring(1).trim().startsWith("define"))
+                        continue;
+                    definition = new StringBuilder();
+                }
+                if (line.endsWith("\\")) {
+                    definition.append(line, 0, line.length() - 1).append(' ');
+                } else {
+                    define(definition.append(line).toString());
+                    definition = null;
+                }
+            }
+            if (definition != null)
+                define(definition.toString());
+        }
+    }
+
+    public void undefine(String name) {
+        macros.remove(name);
+        clearCache();
+    }
+
+    public Macro get(String name) {
+        return macros.get(name);
+    }
+
+    public boolean isEmpty() {
+        return macros.isEmpty();
+    }
+
+    /**
+     * All definitions in a canonical order, for telling tables apart, e.g.
+     * in {@link ParseCache} keys.
+     */
+    public String fingerprint() {
+        List<String> definitions = new ArrayList<>();
+        for (Macro macro : macros.values())
+            definitions.add(macro.definition);
+        Collections.sort(definitions);
+        StringBuilder sb = new StringBuilder();
+        for (String definition : definitions)
+            sb.append(definition).append('\n');
+        return sb.toString();
+    }
+
+    public long getCacheHitCount() {
+        return cacheHits.get();
+    }
+
+    public long getCacheMissCount() {
+        return cacheMisses.get();
+    }
+
+    /**
+     * The replacement tokens of an invocation before rescanning, taken from
+     * the cache when the same macro was invoked with the same arguments
+     * before. The tokens only carry a type and text.
+     */
+    List<Token> expand(Macro macro, List<List<Token>> args) {
+        StringBuilder key = new StringBuilder(macro.name);
+        for (List<Token> arg : args) {
+            key.append('\u0000');
+            for (Token token : arg)
+                key.append(token.getText()).append(' ');
+        }
+        String cacheKey = key.toString();
+        synchronized (cache) {
+            List<Token> cached = cache.get(cacheKey);
+            if (cached != null) {
+                cacheHits.incrementAndGet();
+                return cached;
+            }
+        }
+        cacheMisses.incrementAndGet();
+        List<Token> expansion = Collections.unmodifiableList(paste(substitute(macro, args)));
+        synchronized (cache) {
+            cache.put(cacheKey, expansion);
+        }
+        return expansion;
+    }
+
+    private List<Token> substitute(Macro macro, List<List<Token>> args) {
+        List<Token> result = new ArrayList<>();
+        for (int i = 0; i < macro.body.size(); i++) {
+            Token token = macro.body.get(i);
+            int param = macro.param(token);
+            if (token.getText().equals(STRINGIZE) && i + 1 < macro.body.size()
+                    && macro.param(macro.body.get(i + 1)) >= 0) {
+                result.add(stringize(arg(args, macro.param(macro.body.get(++i)))));
+            } else if (param >= 0) {
+                // Copies, since the expansion is cached and the argument tokens belong to the file being lexed.
+                for (Token arg : arg(args, param))
+                    result.add(new CommonToken(arg.getType(), arg.getText()));
+            } else {
+                result.add(token);
+            }
+        }
+        return result;
+    }
+
+    private static List<Token> arg(List<List<Token>> args, int param) {
+        return param < args.size() ? args.get(param) : Collections.<Token>emptyList();
+    }
+
+    /**
+     * Joins the tokens on either side of each paste marker into one.
+     */
+    private static List<Token> paste(List<Token> tokens) {
+        List<Token> result = new ArrayList<>();
+        for (int i = 0; i < tokens.size(); i++) {
+            Token token = tokens.get(i);
+            if (!token.getText().equals(PASTE)) {
+                result.add(token);
+                continue;
+            }
+            if (result.isEmpty() || i + 1 >= tokens.size())
+                continue;
+            String text = result.remove(result.size() - 1).getText() + tokens.get(++i).getText();
+            List<Token> relexed = lex(text);
+            result.add(relexed.size() == 1 ? relexed.get(0) : new CommonToken(CPPCXLexer.Identifier, text));
+        }
+        return result;
+    }
+
+    private static Token stringize(List<Token> arg) {
+        StringBuilder sb = new StringBuilder("\"");
+        for (int i = 0; i < arg.size(); i++) {
+            if (i > 0)
+                sb.append(' ');
+            sb.append(arg.get(i).getText().replace("\\", "\\\\").replace("\"", "\\\""));
+        }
+        return new CommonToken(CPPCXLexer.StringLiteral, sb.append('"').toString());
+    }
+
+    /**
+     * Default channel tokens of a snippet as plain type and text.
+     */
+    private static List<Token> lex(String text) {
+        CPPCXLexer lexer = new CPPCXLexer(CharStreams.fromString(text));
+        lexer.removeErrorListeners();
+        List<Token> tokens = new ArrayList<>();
+        for (Token token = lexer.nextToken(); token.getType() != Token.EOF; token = lexer.nextToken()) {
+            if (token.getChannel() == Token.DEFAULT_CHANNEL)
+                tokens.add(new CommonToken(token.getType(), token.getText()));
+        }
+        return tokens;
+    }
+
+    private void clearCache() {
+        synchronized (cache) {
+            cache.clear();
+        }
+    }
+
+    /**
+     * A macro definition with its replacement list lexed.
+     */
+    public static class Macro {
+        private final String name;
+        private final List<String> params;
+        private final List<Token> body;
+        private final String definition;
+
+        Macro(String name, List<String> params, List<Token> body, String definition) {
+            this.name = name;
+            this.params = params;
+            this.body = body;
+            this.definition = definition;
+        }
+
+        public String getName() {
+            return name;
+        }
+
+        /**
+         * Whether the macro takes arguments, even an empty list.
+         */
+        public boolean isFunctionLike() {
+            return params != null;
+        }
+
+        /**
+         * The parameter names, {@code __VA_ARGS__} for {@code ...}; null for
+         * an object-like macro.
+         */
+        public List<String> getParams() {
+            return params == null ? null : Collections.unmodifiableList(params);
+        }
+
+        boolean isVariadic() {
+            return params != null && !params.isEmpty() && params.get(params.size() - 1).equals(VA_ARGS);
+        }
+
+        private int param(Token token) {
+            return params == null || token.getType() != CPPCXLexer.Identifier ? -1 : params.indexOf(token.getText());
+        }
+    }
+}
@@ -0,0 +1,264 @@
+package com.microsoft.calculator;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.IntStream;
+import org.antlr.v4.runtime.misc.Interval;
+
+/**
+ * A {@link CharStream} over a memory-mapped UTF-8 file, read in place.
+ *
+ * {@link org.antlr.v4.runtime.CharStreams#fromPath} decodes the whole file
+ * into an array of code points first. This stream decodes code points from
+ * the mapped bytes as the lexer asks for them, so the file is neither copied
+ * nor decoded up front. Pure ASCII files, which most sources are, are
+ * indexed by byte offset directly. Other files get one byte offset per
+ * {@value #STRIDE} code points, so seeking decodes at most that many; the
+ * lexer mostly moves forward by one, which needs no index at all.
+ *
+ * A UTF-8 byte order mark is skipped. Malformed sequences decode to U+FFFD,
+ * one per byte that is not a continuation byte, so the count of replacement
+ * characters can differ from {@code CharStreams}. Like the code point
+ * streams of ANTLR the stream keeps all input, so {@link #mark} and
+ * {@link #release} do nothing. Not safe to share between threads.
+ */
+public class MappedCharStream implements CharStream {
+
+    static final int STRIDE = 64;
+
+    private static final int REPLACEMENT = 0xFFFD;
+
+    private final ByteBuffer bytes;
+    private final String name;
+    private final int size;
+    private final boolean ascii;
+    /** Byte offset of every {@link #STRIDE}th code point, null for ASCII. */
+    private final int[] checkpoints;
+    private int index;
+    /** Byte offset of the code point at {@link #index}. */
+    private int position;
+
+    /**
+     * Maps the file, or fails for files of 2 GB or more, which cannot be
+     * mapped in one piece.
+     */
+    public static MappedCharStream fromPath(Path file) throws IOException {
+        try (FileChannel channel = FileChannel.open(file, StandardOpenOption.READ)) {
+            if (channel.size() > Integer.MAX_VALUE)
+                throw new IOException(file + " is too large to map");
+            return new MappedCharStream(channel.map(FileChannel.MapMode.READ_ONLY, 0, channel.size()),
+                    file.toString());
+        }
+    }
+
+    /**
+     * A stream over the UTF-8 bytes between the buffer's position and limit.
+     */
+    public MappedCharStream(ByteBuffer buffer, String name) {
+        ByteBuffer bytes = buffer.slice();
+        if (bytes.limit() >= 3 && (bytes.get(0) & 0xff) == 0xef && (bytes.get(1) & 0xff) == 0xbb
+                && (bytes.get(2) & 0xff) == 0xbf) {
+            bytes.position(3);
+            bytes = bytes.slice();
+        }
+        this.bytes = bytes;
+        this.name = name == null || name.isEmpty() ? UNKNOWN_SOURCE_NAME : name;
+
+        int limit = bytes.limit();
+        boolean ascii = true;
+        for (int i = 0; i < limit && ascii; i++)
+            ascii = bytes.get(i) >= 0;
+        this.ascii = ascii;
+        if (ascii) {
+            size = limit;
+            checkpoints = null;
+            return;
+        }
+
+        int count = 0;
+        int[] checkpoints = new int[limit / STRIDE + 1];
+        for (int i = 0; i < limit; i++) {
+            if (i > 0 && isContinuation(i))
+                continue;
+            if (count % STRIDE == 0)
+                checkpoints[count / STRIDE] = i;
+            count++;
+        }
+        size = count;
+        this.checkpoints = checkpoints;
+    }
+
+    /**
+     * Whether the input is pure ASCII and indexed by byte offset.
+     */
+    public boolean isAscii() {
+        return ascii;
+    }
+
+    @Override
+    public void consume() {
+        if (index >= size)
+            throw new IllegalStateException("cannot consume EOF");
+        index++;
+        position = ascii ? index : next(position);
+    }
+
+    @Override
+    public int LA(int i) {
+        if (i == 0)
+            return 0;
+        if (i > 0) {
+            if (index + i - 1 >= size)
+                return IntStream.EOF;
+            if (ascii)
+                return bytes.get(index + i - 1);
+            int p = position;
+            for (int k = 1; k < i; k++)
+                p = next(p);
+            return decode(p);
+        }
+        if (index + i < 0)
+            return IntStream.EOF;
+        if (ascii)
+            return bytes.get(index + i);
+        int p = position;
+        for (int k = 0; k > i; k--)
+            p = previous(p);
+        return decode(p);
+    }
+
+    @Override
+    public int mark() {
+        return -1;
+    }
+
+    @Override
+    public void release(int marker) {
+    }
+
+    @Override
+    public int index() {
+        return index;
+    }
+
+    @Override
+    public void seek(int index) {
+        index = Math.max(0, Math.min(index, size));
+        if (ascii) {
+            this.index = index;
+            this.position = index;
+            return;
+        }
+        position = offset(index, this.index, position);
+        this.index = index;
+    }
+
+    @Override
+    public int size() {
+        return size;
+    }
+
+    @Override
+    public String getSourceName() {
+        return name;
+    }
+
+    @Override
+    public String getText(Interval interval) {
+        int start = Math.max(0, interval.a);
+        int stop = Math.min(interval.b, size - 1);
+        if (stop < start)
+            return "";
+        if (ascii) {
+            byte[] text = new byte[stop - start + 1];
+            ByteBuffer view = bytes.duplicate();
+            view.position(start);
+            view.get(text);
+            return new String(text, StandardCharsets.US_ASCII);
+        }
+        StringBuilder sb = new StringBuilder(stop - start + 1);
+        int p = offset(start, index, position);
+        for (int i = start; i <= stop; i++) {
+            sb.appendCodePoint(decode(p));
+            p = next(p);
+        }
+        return sb.toString();
+    }
+
+    @Override
+    public String toString() {
+        return getText(Interval.of(0, size - 1));
+    }
+
+    /**
+     * The byte offset of a code point of non-ASCII input, walking from the
+     * current position when it is close and from a checkpoint otherwise.
+     */
+    private int offset(int target, int from, int fromOffset) {
+        int p;
+        int i;
+        if (target >= from && target - from < STRIDE) {
+            p = fromOffset;
+            i = from;
+        } else {
+            i = target / STRIDE * STRIDE;
+            if (i >= size)
+                return bytes.limit();
+            p = checkpoints[i / STRIDE];
+        }
+        for (; i < target; i++)
+            p = next(p);
+        return p;
+    }
+
+    private boolean isContinuation(int offset) {
+        return (bytes.get(offset) & 0xc0) == 0x80;
+    }
+
+    private int next(int offset) {
+        int p = offset + 1;
+        while (p < bytes.limit() && isContinuation(p))
+            p++;
+        return p;
+    }
+
+    private int previous(int offset) {
+        int p = offset - 1;
+        while (p > 0 && isContinuation(p))
+            p--;
+        return p;
+    }
+
+    private int decode(int offset) {
+        int b = bytes.get(offset) & 0xff;
+        if (b < 0x80)
+            return b;
+        int length;
+        int codePoint;
+        if (b >= 0xc0 && b < 0xe0) {
+            length = 1;
+            codePoint = b & 0x1f;
+        } else if (b >= 0xe0 && b < 0xf0) {
+            length = 2;
+            codePoint = b & 0x0f;
+        } else if (b >= 0xf0 && b < 0xf8) {
+            length = 3;
+            codePoint = b & 0x07;
+        } else {
+            return REPLACEMENT;
+        }
+        for (int k = 1; k <= length; k++) {
+            int p = offset + k;
+            if (p >= bytes.limit() || !isContinuation(p))
+                return REPLACEMENT;
+            codePoint = codePoint << 6 | bytes.get(p) & 0x3f;
+        }
+        return Character.isValidCodePoint(codePoint) ? codePoint : REPLACEMENT;
+    }
+}
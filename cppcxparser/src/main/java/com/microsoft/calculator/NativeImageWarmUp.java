@@ -0,0 +1,31 @@
+package com.microsoft.calculator;
+
+import java.io.IOException;
+
+/**
+ * Runs {@link DfaCache#warmUp()} when the class is initialized, which for
+ * the native image built with {@code -Pnative} happens at build time.
+ *
+ * The lexer and parser classes are initialized at build time as well, see
+ * META-INF/native-image, so the executable starts with their ATNs
+ * deserialized and the DFA this parse populated in its image heap instead
+ * of building either on every run. {@link App} only refers to the class in
+ * the image, so on the JVM it is never initialized.
+ */
+final class NativeImageWarmUp {
+
+    /** DFA states populated at initialization. */
+    static final int DFA_STATES;
+
+    static {
+        try {
+            DfaCache.warmUp();
+        } catch (IOException e) {
+            throw new IllegalStateException("cannot read the bundled example", e);
+        }
+        DFA_STATES = DfaCache.stateCount();
+    }
+
+    private NativeImageWarmUp() {
+    }
+}
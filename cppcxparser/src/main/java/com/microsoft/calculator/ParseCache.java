@@ -0,0 +1,162 @@
+package com.microsoft.calculator;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.IOException;
+import java.io.ObjectInputStream;
+import java.io.ObjectOutputStream;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.NoSuchFileException;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import java.util.concurrent.atomic.AtomicLong;
+
+import com.microsoft.CPPCXFastLexer;
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+
+/**
+ * Stores the {@link ApiModel} of each parsed file on disk, keyed by the
+ * SHA-256 of the file content and the grammar version.
+ *
+ * The grammar version is the hash of the serialized ATNs of the generated
+ * lexers and parser, so any change to CPPCXLexer.g4, CPPCXFastLexer.g4 or
+ * CPPCXParser.g4 that affects recognition gives every file a new key. The
+ * {@link KeywordTable} is built from the CPPCXLexer vocabulary and is
+ * covered by its ATN. {@link #FORMAT} is bumped
+ * when {@link CxListener} extracts something different from the same tree.
+ * Settings that change the extracted model for the same content, such as
+ * the macro table or skipping function bodies, are passed as the
+ * configuration and also hashed into every key. Entries that cannot be
+ * read, for instance after {@link ApiModel} changed incompatibly, are
+ * treated as misses.
+ *
+ * Entries are written to a temporary file and moved into place, so
+ * concurrent writers and readers, including other processes sharing the
+ * directory, never see a partial entry.
+ */
+public class ParseCache {
+
+    /**
+     * Version of the extraction, part of every key.
+     */
+    public static final int FORMAT = 2;
+
+    private static final String GRAMMAR_VERSION = grammarVersion();
+
+    private final Path directory;
+    private final String configuration;
+    private final AtomicLong hits = new AtomicLong();
+    private final AtomicLong misses = new AtomicLong();
+
+    public ParseCache(Path directory) throws IOException {
+        this(directory, "");
+    }
+
+    public ParseCache(Path directory, String configuration) throws IOException {
+        this.directory = Files.createDirectories(directory);
+        this.configuration = configuration;
+    }
+
+    public Path getDirectory() {
+        return directory;
+    }
+
+    /**
+     * The cached model of a file with the given content, or null.
+     */
+    public ApiModel get(byte[] content) {
+        Path entry = entry(key(configuration, content));
+        try (ObjectInputStream in = new ObjectInputStream(new BufferedInputStream(Files.newInputStream(entry)))) {
+            ApiModel model = (ApiModel) in.readObject();
+            hits.incrementAndGet();
+            return model;
+        } catch (NoSuchFileException e) {
+            // A plain miss.
+        } catch (IOException | ClassNotFoundException | ClassCastException e) {
+            // A stale or damaged entry, which the next put replaces.
+        }
+        misses.incrementAndGet();
+        return null;
+    }
+
+    public void put(byte[] content, ApiModel model) throws IOException {
+        Path entry = entry(key(configuration, content));
+        Path temp = Files.createTempFile(directory, entry.getFileName().toString(), ".tmp");
+        try {
+            try (ObjectOutputStream out = new ObjectOutputStream(
+                    new BufferedOutputStream(Files.newOutputStream(temp)))) {
+                out.writeObject(model);
+            }
+            Files.move(temp, entry, StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+        } finally {
+            Files.deleteIfExists(temp);
+        }
+    }
+
+    public long getHitCount() {
+        return hits.get();
+    }
+
+    public long getMissCount() {
+        return misses.get();
+    }
+
+    @Override
+    public String toString() {
+        return "cache hits: " + getHitCount() + ", misses: " + getMissCount();
+    }
+
+    /**
+     * Hex SHA-256 of the format, grammar version, configuration and content.
+     */
+    static String key(String configuration, byte[] content) {
+        MessageDigest digest = sha256();
+        digest.update(("" + FORMAT + ':' + GRAMMAR_VERSION + ':').getBytes(StandardCharsets.UTF_8));
+        update(digest, configuration);
+        digest.update((byte) 0);
+        return hex(digest.digest(content));
+    }
+
+    static String grammarVersion() {
+        MessageDigest digest = sha256();
+        update(digest, CPPCXLexer._serializedATN);
+        update(digest, CPPCXFastLexer._serializedATN);
+        update(digest, CPPCXParser._serializedATN);
+        return hex(digest.digest());
+    }
+
+    /**
+     * Hashes the UTF-16 code units, since the serialized ATN is not valid
+     * Unicode text.
+     */
+    private static void update(MessageDigest digest, String s) {
+        for (int i = 0; i < s.length(); i++) {
+            char c = s.charAt(i);
+            digest.update((byte) (c >> 8));
+            digest.update((byte) c);
+        }
+    }
+
+    private Path entry(String key) {
+        return directory.resolve(key + ".model");
+    }
+
+    private static MessageDigest sha256() {
+        try {
+            return MessageDigest.getInstance("SHA-256");
+        } catch (NoSuchAlgorithmException e) {
+            throw new IllegalStateException(e);
+        }
+    }
+
+    private static String hex(byte[] bytes) {
+        StringBuilder sb = new StringBuilder(bytes.length * 2);
+        for (byte b : bytes)
+            sb.append(Character.forDigit((b >> 4) & 0xf, 16)).append(Character.forDigit(b & 0xf, 16));
+        return sb.toString();
+    }
+}
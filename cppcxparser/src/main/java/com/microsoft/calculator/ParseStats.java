@@ -0,0 +1,340 @@
+package com.microsoft.calculator;
+
+import java.io.IOException;
+import java.io.Writer;
+import java.lang.management.ManagementFactory;
+import java.lang.management.MemoryPoolMXBean;
+import java.lang.management.MemoryType;
+import java.lang.management.ThreadMXBean;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.List;
+
+import com.microsoft.CPPCXParser;
+
+import org.antlr.v4.runtime.atn.DecisionInfo;
+import org.antlr.v4.runtime.atn.DecisionState;
+import org.antlr.v4.runtime.tree.ParseTree;
+
+/**
+ * Collects per-file timings and sizes and per-decision prediction statistics
+ * of a batch run and writes them as JSON.
+ *
+ * Lexing is timed apart from parsing by filling the token stream first.
+ * Memory is reported as the bytes each file allocated on its worker thread,
+ * where the JVM supports it, and the peak heap of the whole run, since heap
+ * use cannot be attributed to one file while several are parsed at once.
+ * Decision statistics come from ANTLR's profiling ATN simulator and are
+ * summed over all files; they tell which decisions of CPPCXParser.g4 need
+ * the most lookahead and fall back to full LL. Safe to share between
+ * threads.
+ */
+public class ParseStats {
+
+    private static final ThreadMXBean THREADS = ManagementFactory.getThreadMXBean();
+
+    private final List<FileStats> files = new ArrayList<>();
+    private final DecisionStats[] decisions;
+    private final long startNanos = System.nanoTime();
+
+    public ParseStats() {
+        for (MemoryPoolMXBean pool : ManagementFactory.getMemoryPoolMXBeans()) {
+            if (pool.getType() == MemoryType.HEAP)
+                pool.resetPeakUsage();
+        }
+        String[] ruleNames = CPPCXParser.ruleNames;
+        decisions = new DecisionStats[CPPCXParser._ATN.getNumberOfDecisions()];
+        for (int i = 0; i < decisions.length; i++) {
+            DecisionState state = CPPCXParser._ATN.getDecisionState(i);
+            decisions[i] = new DecisionStats(i, ruleNames[state.ruleIndex]);
+        }
+    }
+
+    /**
+     * Bytes allocated by the current thread so far, or -1 if unsupported.
+     */
+    static long allocatedBytes() {
+        if (THREADS instanceof com.sun.management.ThreadMXBean) {
+            com.sun.management.ThreadMXBean threads = (com.sun.management.ThreadMXBean) THREADS;
+            if (threads.isThreadAllocatedMemoryEnabled())
+                return threads.getThreadAllocatedBytes(Thread.currentThread().getId());
+        }
+        return -1;
+    }
+
+    /**
+     * Number of rule and terminal nodes in a tree.
+     */
+    static int countNodes(ParseTree tree) {
+        int count = 1;
+        for (int i = 0; i < tree.getChildCount(); i++)
+            count += countNodes(tree.getChild(i));
+        return count;
+    }
+
+    synchronized void addFile(FileStats file) {
+        files.add(file);
+    }
+
+    /**
+     * Adds the statistics of a profiling parser, see
+     * {@link CPPCXParser#setProfile(boolean)}.
+     */
+    synchronized void addDecisions(DecisionInfo[] infos) {
+        for (DecisionInfo info : infos)
+            decisions[info.decision].add(info);
+    }
+
+    public synchronized List<FileStats> getFiles() {
+        return new ArrayList<>(files);
+    }
+
+    /**
+     * Decisions that were predicted at least once, most expensive first.
+     */
+    public synchronized List<DecisionStats> getDecisions() {
+        List<DecisionStats> used = new ArrayList<>();
+        for (DecisionStats decision : decisions) {
+            if (decision.invocations > 0)
+                used.add(decision.copy());
+        }
+        Collections.sort(used, new Comparator<DecisionStats>() {
+            @Override
+            public int compare(DecisionStats a, DecisionStats b) {
+                return Long.compare(b.timeInPrediction, a.timeInPrediction);
+            }
+        });
+        return used;
+    }
+
+    public static long peakHeapBytes() {
+        long peak = 0;
+        for (MemoryPoolMXBean pool : ManagementFactory.getMemoryPoolMXBeans()) {
+            if (pool.getType() == MemoryType.HEAP)
+                peak += pool.getPeakUsage().getUsed();
+        }
+        return peak;
+    }
+
+    public void writeJson(Writer writer) throws IOException {
+        List<FileStats> fileList = getFiles();
+        FileStats total = new FileStats(null);
+        for (FileStats file : fileList)
+            total.add(file);
+
+        JsonWriter json = new JsonWriter(writer);
+        json.beginObject();
+        json.name("wallMs").value(millis(System.nanoTime() - startNanos));
+        json.name("peakHeapBytes").value(peakHeapBytes());
+        json.name("total");
+        total.write(json);
+        json.name("files").beginArray();
+        for (FileStats file : fileList)
+            file.write(json);
+        json.endArray();
+        json.name("decisions").beginArray();
+        for (DecisionStats decision : getDecisions())
+            decision.write(json);
+        json.endArray();
+        json.endObject();
+        json.flush();
+    }
+
+    private static double millis(long nanos) {
+        return nanos / 1e6;
+    }
+
+    /**
+     * Measurements of one file. Streamed files have no separate lex time and
+     * no token or node count, which are -1.
+     */
+    public static class FileStats {
+        private final Path file;
+        long lexNanos;
+        long parseNanos;
+        long walkNanos;
+        long tokens;
+        long nodes;
+        long allocatedBytes;
+        int syntaxErrors;
+
+        FileStats(Path file) {
+            this.file = file;
+        }
+
+        public Path getFile() {
+            return file;
+        }
+
+        public long getLexNanos() {
+            return lexNanos;
+        }
+
+        public long getParseNanos() {
+            return parseNanos;
+        }
+
+        public long getWalkNanos() {
+            return walkNanos;
+        }
+
+        public long getTokens() {
+            return tokens;
+        }
+
+        public long getNodes() {
+            return nodes;
+        }
+
+        /**
+         * Bytes allocated while the file was processed, or -1.
+         */
+        public long getAllocatedBytes() {
+            return allocatedBytes;
+        }
+
+        public int getSyntaxErrors() {
+            return syntaxErrors;
+        }
+
+        private void add(FileStats other) {
+            lexNanos += other.lexNanos;
+            parseNanos += other.parseNanos;
+            walkNanos += other.walkNanos;
+            tokens += Math.max(0, other.tokens);
+            nodes += Math.max(0, other.nodes);
+            allocatedBytes += Math.max(0, other.allocatedBytes);
+            syntaxErrors += other.syntaxErrors;
+        }
+
+        private void write(JsonWriter json) throws IOException {
+            json.beginObject();
+            if (file != null)
+                json.name("file").value(file.toString());
+            json.name("lexMs").value(millis(lexNanos));
+            json.name("parseMs").value(millis(parseNanos));
+            json.name("walkMs").value(millis(walkNanos));
+            json.name("tokens").value(tokens);
+            json.name("nodes").value(nodes);
+            json.name("allocatedBytes").value(allocatedBytes);
+            json.name("syntaxErrors").value(syntaxErrors);
+            json.endObject();
+        }
+    }
+
+    /**
+     * Prediction statistics of one decision summed over all files.
+     */
+    public static class DecisionStats {
+        private final int decision;
+        private final String rule;
+        long invocations;
+        long timeInPrediction;
+        long sllTotalLook;
+        long sllMaxLook;
+        long llFallback;
+        long llTotalLook;
+        long llMaxLook;
+        long ambiguities;
+        long contextSensitivities;
+        long errors;
+
+        DecisionStats(int decision, String rule) {
+            this.decision = decision;
+            this.rule = rule;
+        }
+
+        public int getDecision() {
+            return decision;
+        }
+
+        /**
+         * The rule the decision belongs to.
+         */
+        public String getRule() {
+            return rule;
+        }
+
+        public long getInvocations() {
+            return invocations;
+        }
+
+        public long getTimeInPrediction() {
+            return timeInPrediction;
+        }
+
+        public long getLlFallback() {
+            return llFallback;
+        }
+
+        public long getSllMaxLook() {
+            return sllMaxLook;
+        }
+
+        public long getLlMaxLook() {
+            return llMaxLook;
+        }
+
+        public long getAmbiguities() {
+            return ambiguities;
+        }
+
+        /**
+         * Predictions where SLL saw a conflict that full LL resolved.
+         */
+        public long getContextSensitivities() {
+            return contextSensitivities;
+        }
+
+        public long getErrors() {
+            return errors;
+        }
+
+        private void add(DecisionInfo info) {
+            invocations += info.invocations;
+            timeInPrediction += info.timeInPrediction;
+            sllTotalLook += info.SLL_TotalLook;
+            sllMaxLook = Math.max(sllMaxLook, info.SLL_MaxLook);
+            llFallback += info.LL_Fallback;
+            llTotalLook += info.LL_TotalLook;
+            llMaxLook = Math.max(llMaxLook, info.LL_MaxLook);
+            ambiguities += info.ambiguities.size();
+            contextSensitivities += info.contextSensitivities.size();
+            errors += info.errors.size();
+        }
+
+        private DecisionStats copy() {
+            DecisionStats copy = new DecisionStats(decision, rule);
+            copy.invocations = invocations;
+            copy.timeInPrediction = timeInPrediction;
+            copy.sllTotalLook = sllTotalLook;
+            copy.sllMaxLook = sllMaxLook;
+            copy.llFallback = llFallback;
+            copy.llTotalLook = llTotalLook;
+            copy.llMaxLook = llMaxLook;
+            copy.ambiguities = ambiguities;
+            copy.contextSensitivities = contextSensitivities;
+            copy.errors = errors;
+            return copy;
+        }
+
+        private void write(JsonWriter json) throws IOException {
+            json.beginObject();
+            json.name("decision").value(decision);
+            json.name("rule").value(rule);
+            json.name("invocations").value(invocations);
+            json.name("timeInPredictionMs").value(millis(timeInPrediction));
+            json.name("sllTotalLook").value(sllTotalLook);
+            json.name("sllMaxLook").value(sllMaxLook);
+            json.name("llFallback").value(llFallback);
+            json.name("llTotalLook").value(llTotalLook);
+            json.name("llMaxLook").value(llMaxLook);
+            json.name("ambiguities").value(ambiguities);
+            json.name("contextSensitivities").value(contextSensitivities);
+            json.name("errors").value(errors);
+            json.endObject();
+        }
+    }
+}
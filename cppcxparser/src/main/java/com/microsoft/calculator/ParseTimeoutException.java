@@ -0,0 +1,40 @@
+package com.microsoft.calculator;
+
+import org.antlr.v4.runtime.misc.ParseCancellationException;
+
+/**
+ * Thrown by {@link CancellableTokenStream} when a parse runs past its
+ * deadline or is cancelled. Unlike other cancellations it is not a syntax
+ * error, so {@link TwoStageParser} passes it on rather than re-parsing.
+ */
+public class ParseTimeoutException extends ParseCancellationException {
+    private static final long serialVersionUID = 1L;
+
+    private final String sourceName;
+    private final long elapsedMillis;
+    private final boolean cancelled;
+
+    public ParseTimeoutException(String sourceName, long elapsedMillis, boolean cancelled) {
+        super((cancelled ? "parse cancelled after " : "parse timed out after ") + elapsedMillis + " ms: "
+                + sourceName);
+        this.sourceName = sourceName;
+        this.elapsedMillis = elapsedMillis;
+        this.cancelled = cancelled;
+    }
+
+    public String getSourceName() {
+        return sourceName;
+    }
+
+    public long getElapsedMillis() {
+        return elapsedMillis;
+    }
+
+    /**
+     * Whether the parse was cancelled or its thread interrupted rather than
+     * out of time.
+     */
+    public boolean isCancelled() {
+        return cancelled;
+    }
+}
@@ -0,0 +1,141 @@
+package com.microsoft.calculator;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.TokenSource;
+
+/**
+ * A lexer, token stream and parser that parse one {@link Request} after
+ * another.
+ *
+ * The instances, the token buffer and the error listeners are set up once
+ * and only reset per request, which matters when parsing thousands of small
+ * snippets a second. A {@link Response} holds the extracted model and
+ * diagnostics but no tokens or tree, so it stays valid after the session
+ * moves on. A session is confined to one thread at a time; a
+ * {@link ParserSessionPool} hands them out.
+ */
+public class ParserSession {
+
+    private final TwoStageParser twoStage;
+    private final MacroTable macros;
+    private final CPPCXLexer lexer = new CPPCXLexer(CharStreams.fromString(""));
+    private final CommonTokenStream tokens = new CommonTokenStream(lexer);
+    private final CPPCXParser parser = new CPPCXParser(tokens);
+    private final DiagnosticCollector diagnostics = new DiagnosticCollector();
+
+    public ParserSession() {
+        this(new TwoStageParser(), null);
+    }
+
+    /**
+     * @param macros expanded before parsing, or null
+     */
+    public ParserSession(TwoStageParser twoStage, MacroTable macros) {
+        this.twoStage = twoStage;
+        this.macros = macros;
+        lexer.removeErrorListeners();
+        lexer.addErrorListener(diagnostics);
+        parser.removeErrorListeners();
+        parser.addErrorListener(diagnostics);
+    }
+
+    public Response parse(Request request) {
+        diagnostics.clear();
+        lexer.setInputStream(CharStreams.fromString(request.getText(), request.getSourceName()));
+        TokenSource source = lexer;
+        if (macros != null)
+            source = new MacroExpandingTokenSource(source, macros);
+        if (request.isSkipBodies())
+            source = new SkipBodyTokenSource(source);
+        tokens.setTokenSource(source);
+        parser.setInputStream(tokens);
+        try {
+            ApiModel model = ApiModelBuilder.build(twoStage.parse(parser));
+            return new Response(request.getSourceName(), model, parser.getNumberOfSyntaxErrors(),
+                    new ArrayList<>(diagnostics.getDiagnostics()));
+        } finally {
+            // Drop the request's tokens and tree until the next one.
+            tokens.setTokenSource(lexer);
+            parser.setInputStream(tokens);
+        }
+    }
+
+    /**
+     * Source text to parse as a translation unit.
+     */
+    public static class Request {
+        private final String sourceName;
+        private final String text;
+        private final boolean skipBodies;
+
+        public Request(String sourceName, String text) {
+            this(sourceName, text, false);
+        }
+
+        /**
+         * @param skipBodies parse function bodies as empty, see
+         *            {@link SkipBodyTokenSource}
+         */
+        public Request(String sourceName, String text, boolean skipBodies) {
+            this.sourceName = sourceName;
+            this.text = text;
+            this.skipBodies = skipBodies;
+        }
+
+        public String getSourceName() {
+            return sourceName;
+        }
+
+        public String getText() {
+            return text;
+        }
+
+        public boolean isSkipBodies() {
+            return skipBodies;
+        }
+    }
+
+    /**
+     * What a request parsed to.
+     */
+    public static class Response {
+        private final String sourceName;
+        private final ApiModel model;
+        private final int syntaxErrors;
+        private final List<DiagnosticCollector.Diagnostic> diagnostics;
+
+        Response(String sourceName, ApiModel model, int syntaxErrors,
+                List<DiagnosticCollector.Diagnostic> diagnostics) {
+            this.sourceName = sourceName;
+            this.model = model;
+            this.syntaxErrors = syntaxErrors;
+            this.diagnostics = diagnostics;
+        }
+
+        public String getSourceName() {
+            return sourceName;
+        }
+
+        public ApiModel getModel() {
+            return model;
+        }
+
+        public int getSyntaxErrors() {
+            return syntaxErrors;
+        }
+
+        /**
+         * The lexer and parser errors of the request.
+         */
+        public List<DiagnosticCollector.Diagnostic> getDiagnostics() {
+            return diagnostics;
+        }
+    }
+}
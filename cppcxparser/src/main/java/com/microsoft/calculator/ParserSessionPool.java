@@ -0,0 +1,83 @@
+package com.microsoft.calculator;
+
+import java.util.concurrent.ArrayBlockingQueue;
+import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * Hands out {@link ParserSession}s for a service that parses requests on
+ * many threads.
+ *
+ * A session is used by one thread between {@link #acquire} and
+ * {@link #release}; {@link #parse} does both around one request. Sessions
+ * are created when none is idle and at most {@code maxIdle} are kept for
+ * reuse. All sessions share one {@link TwoStageParser} and macro table.
+ * Safe to share between threads.
+ */
+public class ParserSessionPool {
+
+    private final TwoStageParser twoStage = new TwoStageParser();
+    private final MacroTable macros;
+    private final BlockingQueue<ParserSession> idle;
+    private final AtomicLong created = new AtomicLong();
+    private final AtomicLong reused = new AtomicLong();
+
+    public ParserSessionPool() {
+        this(Runtime.getRuntime().availableProcessors(), null);
+    }
+
+    /**
+     * @param macros expanded before parsing, or null; must not change while
+     *            the pool is in use
+     */
+    public ParserSessionPool(int maxIdle, MacroTable macros) {
+        if (maxIdle < 1)
+            throw new IllegalArgumentException("maxIdle must be positive: " + maxIdle);
+        this.idle = new ArrayBlockingQueue<>(maxIdle);
+        this.macros = macros;
+    }
+
+    public TwoStageParser getTwoStageParser() {
+        return twoStage;
+    }
+
+    public ParserSession acquire() {
+        ParserSession session = idle.poll();
+        if (session != null) {
+            reused.incrementAndGet();
+            return session;
+        }
+        created.incrementAndGet();
+        return new ParserSession(twoStage, macros);
+    }
+
+    /**
+     * Returns a session from {@link #acquire} for reuse; the caller must not
+     * use it afterwards.
+     */
+    public void release(ParserSession session) {
+        idle.offer(session);
+    }
+
+    public ParserSession.Response parse(ParserSession.Request request) {
+        ParserSession session = acquire();
+        try {
+            return session.parse(request);
+        } finally {
+            release(session);
+        }
+    }
+
+    public long getCreatedCount() {
+        return created.get();
+    }
+
+    public long getReusedCount() {
+        return reused.get();
+    }
+
+    @Override
+    public String toString() {
+        return "sessions created: " + created.get() + ", reused: " + reused.get() + ", " + twoStage;
+    }
+}
@@ -0,0 +1,43 @@
+package com.microsoft.calculator;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.CommonToken;
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.TokenSource;
+import org.antlr.v4.runtime.misc.Pair;
+
+/**
+ * A token that {@link InterningTokenFactory} hands out again for the next
+ * file once the parse of the previous one is done.
+ */
+public class PooledToken extends CommonToken {
+    private static final long serialVersionUID = 1L;
+
+    PooledToken() {
+        super(Token.INVALID_TYPE);
+    }
+
+    /**
+     * Makes this a fresh token, as a new {@link CommonToken} with the same
+     * arguments would be.
+     */
+    void reset(Pair<TokenSource, CharStream> source, int type, String text, int channel, int start, int stop,
+            int line, int charPositionInLine) {
+        this.source = source;
+        this.type = type;
+        this.text = text;
+        this.channel = channel;
+        this.start = start;
+        this.stop = stop;
+        this.line = line;
+        this.charPositionInLine = charPositionInLine;
+        this.index = -1;
+    }
+
+    /**
+     * Makes this a fresh token without a source, as {@code new CommonToken(type, text)}.
+     */
+    void reset(int type, String text) {
+        reset(EMPTY_SOURCE, type, text, Token.DEFAULT_CHANNEL, 0, 0, 0, -1);
+    }
+}
@@ -0,0 +1,255 @@
+package com.microsoft.calculator;
+
+import static java.nio.file.StandardWatchEventKinds.ENTRY_CREATE;
+import static java.nio.file.StandardWatchEventKinds.ENTRY_DELETE;
+import static java.nio.file.StandardWatchEventKinds.ENTRY_MODIFY;
+import static java.nio.file.StandardWatchEventKinds.OVERFLOW;
+
+import java.io.Closeable;
+import java.io.IOException;
+import java.nio.file.ClosedWatchServiceException;
+import java.nio.file.FileVisitResult;
+import java.nio.file.Files;
+import java.nio.file.NoSuchFileException;
+import java.nio.file.Path;
+import java.nio.file.SimpleFileVisitor;
+import java.nio.file.WatchEvent;
+import java.nio.file.WatchKey;
+import java.nio.file.WatchService;
+import java.nio.file.attribute.BasicFileAttributes;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.LinkedHashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Keeps an {@link ApiIndex} of a source tree up to date as files change.
+ *
+ * {@link #start} watches every directory below the roots and parses all
+ * sources once. After that, {@link #update} waits for file-change events
+ * and reparses only the files they name, with the {@link BatchParser} and
+ * so with its settings and content-hash cache, and puts the new models into
+ * the index in place. Events are gathered until none arrived for the quiet
+ * period, so a branch switch or a build touching many files becomes one
+ * batch. Files that were deleted are removed from the index, and files
+ * that fail to parse keep their previous model.
+ *
+ * The roots are the files and directories given to
+ * {@link BatchParser#collectSources}; only sources are indexed, by absolute
+ * path. A single thread calls {@link #update} or {@link #run}, the index
+ * can be queried from any. The batch parser is switched to reading files
+ * into the heap, see {@link BatchParser#setMapFiles}, so that the watched
+ * files can still be saved.
+ */
+public class ProjectIndexer implements Closeable {
+
+    /**
+     * Told about every update of the index.
+     */
+    public interface Listener {
+        /**
+         * @param result the results of the files that were parsed
+         * @param removed the files that were removed from the index
+         */
+        void updated(BatchParser.BatchResult result, List<Path> removed);
+    }
+
+    public static final long DEFAULT_QUIET_MILLIS = 100;
+
+    private final BatchParser batch;
+    private final List<Path> roots;
+    private final ApiIndex index = new ApiIndex();
+    private final WatchService watcher;
+    private final Map<WatchKey, Path> directories = new HashMap<>();
+    private long quietMillis = DEFAULT_QUIET_MILLIS;
+    private Listener listener;
+
+    public ProjectIndexer(BatchParser batch, List<Path> roots) throws IOException {
+        if (roots.isEmpty())
+            throw new IllegalArgumentException("no roots");
+        this.batch = batch;
+        batch.setMapFiles(false);
+        this.roots = new ArrayList<>(roots.size());
+        for (Path root : roots)
+            this.roots.add(root.toAbsolutePath().normalize());
+        this.watcher = this.roots.get(0).getFileSystem().newWatchService();
+    }
+
+    public ApiIndex getIndex() {
+        return index;
+    }
+
+    /**
+     * How long no events must arrive before the gathered ones are applied.
+     */
+    public void setQuietPeriod(long quietMillis) {
+        if (quietMillis < 0)
+            throw new IllegalArgumentException("quietMillis: " + quietMillis);
+        this.quietMillis = quietMillis;
+    }
+
+    public void setListener(Listener listener) {
+        this.listener = listener;
+    }
+
+    /**
+     * Watches the roots and indexes all their sources.
+     */
+    public BatchParser.BatchResult start() throws IOException, InterruptedException {
+        for (Path root : roots) {
+            if (Files.isDirectory(root))
+                registerTree(root);
+            else
+                register(root.getParent());
+        }
+        BatchParser.BatchResult result = batch.parse(BatchParser.collectSources(roots));
+        for (BatchParser.FileResult file : result.getFiles())
+            index.put(file.getFile(), file.getModel());
+        return result;
+    }
+
+    /**
+     * Waits up to the timeout for file changes and applies them.
+     *
+     * @return whether any source changed
+     */
+    public boolean update(long timeout, TimeUnit unit) throws IOException, InterruptedException {
+        WatchKey key = watcher.poll(timeout, unit);
+        if (key == null)
+            return false;
+        Set<Path> changed = new LinkedHashSet<>();
+        boolean overflow = false;
+        while (key != null) {
+            overflow |= collect(key, changed);
+            key = watcher.poll(quietMillis, TimeUnit.MILLISECONDS);
+        }
+        if (overflow)
+            changed.addAll(rescan());
+        return apply(changed);
+    }
+
+    /**
+     * Applies changes until the indexer is closed or the thread interrupted.
+     */
+    public void run() throws IOException {
+        try {
+            while (!Thread.currentThread().isInterrupted())
+                update(1, TimeUnit.SECONDS);
+        } catch (ClosedWatchServiceException e) {
+            // Closed from another thread.
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+        }
+    }
+
+    @Override
+    public void close() throws IOException {
+        watcher.close();
+    }
+
+    /**
+     * Adds the paths of the events of the key to the changed ones.
+     *
+     * @return whether events were lost
+     */
+    private boolean collect(WatchKey key, Set<Path> changed) throws IOException {
+        Path directory = directories.get(key);
+        boolean overflow = false;
+        for (WatchEvent<?> event : key.pollEvents()) {
+            if (event.kind() == OVERFLOW) {
+                overflow = true;
+                continue;
+            }
+            if (directory == null)
+                continue;
+            Path path = directory.resolve((Path) event.context());
+            if (event.kind() == ENTRY_CREATE && Files.isDirectory(path)) {
+                registerTree(path);
+                for (Path file : BatchParser.collectSources(Collections.singletonList(path))) {
+                    if (isIndexed(file))
+                        changed.add(file);
+                }
+            } else if (event.kind() == ENTRY_DELETE && index.getModel(path) == null) {
+                // Maybe a directory; its files are gone too.
+                for (Path file : index.getFiles()) {
+                    if (file.startsWith(path))
+                        changed.add(file);
+                }
+            } else if (isIndexed(path)) {
+                changed.add(path);
+            }
+        }
+        if (!key.reset())
+            directories.remove(key);
+        return overflow;
+    }
+
+    /**
+     * The sources now below the roots and the indexed files, to recover from
+     * lost events.
+     */
+    private Set<Path> rescan() throws IOException {
+        for (Path root : roots) {
+            if (Files.isDirectory(root))
+                registerTree(root);
+        }
+        Set<Path> files = new LinkedHashSet<>(BatchParser.collectSources(roots));
+        files.addAll(index.getFiles());
+        return files;
+    }
+
+    private boolean apply(Set<Path> changed) throws InterruptedException {
+        if (changed.isEmpty())
+            return false;
+        List<Path> existing = new ArrayList<>();
+        List<Path> removed = new ArrayList<>();
+        for (Path file : changed) {
+            if (Files.isRegularFile(file))
+                existing.add(file);
+            else if (index.remove(file))
+                removed.add(file);
+        }
+        BatchParser.BatchResult result = batch.parse(existing);
+        for (BatchParser.FileResult file : result.getFiles()) {
+            if (file.getFailure() == null)
+                index.put(file.getFile(), file.getModel());
+            else if (file.getFailure() instanceof NoSuchFileException && index.remove(file.getFile()))
+                removed.add(file.getFile());
+        }
+        if (listener != null)
+            listener.updated(result, removed);
+        return true;
+    }
+
+    /**
+     * Whether the file is a source that is a root or below one.
+     */
+    private boolean isIndexed(Path file) {
+        if (!BatchParser.isSource(file))
+            return false;
+        for (Path root : roots) {
+            if (file.startsWith(root))
+                return true;
+        }
+        return false;
+    }
+
+    private void registerTree(Path root) throws IOException {
+        Files.walkFileTree(root, new SimpleFileVisitor<Path>() {
+            @Override
+            public FileVisitResult preVisitDirectory(Path dir, BasicFileAttributes attrs) throws IOException {
+                register(dir);
+                return FileVisitResult.CONTINUE;
+            }
+        });
+    }
+
+    private void register(Path directory) throws IOException {
+        if (!directories.containsValue(directory))
+            directories.put(directory.register(watcher, ENTRY_CREATE, ENTRY_DELETE, ENTRY_MODIFY), directory);
+    }
+}
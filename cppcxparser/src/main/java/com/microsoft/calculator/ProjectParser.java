@@ -0,0 +1,118 @@
+package com.microsoft.calculator;
+
+import java.io.IOException;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * Parses translation units together with the headers they include.
+ *
+ * Every file, translation unit or header, is parsed exactly once by a
+ * {@link BatchParser}, concurrently and with its settings and cache. The
+ * include graph is built in waves from the directives the parses collect:
+ * the translation units first, then the headers they include that were not
+ * parsed yet, and so on. Only files whose result has no directives, such as
+ * cache hits, are lexed again by the {@link IncludeResolver}. The model of
+ * a translation unit is its own model merged with those of all headers it
+ * includes, so a header included by many units is neither parsed nor stored
+ * more than once.
+ *
+ * Each header is parsed on its own, not in the context of the including
+ * file, which is enough for the declarations the API model holds.
+ */
+public class ProjectParser {
+
+    private final BatchParser batch;
+    private final IncludeResolver resolver;
+
+    public ProjectParser(BatchParser batch, IncludeResolver resolver) {
+        this.batch = batch;
+        this.resolver = resolver;
+    }
+
+    public BatchParser getBatchParser() {
+        return batch;
+    }
+
+    public ProjectResult parse(List<Path> units) throws IOException, InterruptedException {
+        IncludeResolver.IncludeGraph graph = resolver.newGraph(units);
+        List<BatchParser.FileResult> results = new ArrayList<>();
+        List<Path> wave = graph.getFiles();
+        while (!wave.isEmpty()) {
+            List<Path> next = new ArrayList<>();
+            for (BatchParser.FileResult file : batch.parse(wave).getFiles()) {
+                results.add(file);
+                DirectiveIndex directives = file.getDirectives();
+                try {
+                    if (directives == null && file.getFailure() == null)
+                        directives = resolver.directives(file.getFile());
+                } catch (IOException e) {
+                    // Left without includes like a failed file.
+                }
+                if (directives != null)
+                    next.addAll(resolver.addIncludes(graph, file.getFile(), directives));
+            }
+            wave = next;
+        }
+        return new ProjectResult(graph, new BatchParser.BatchResult(results));
+    }
+
+    /**
+     * The include graph and the result of every file in it.
+     */
+    public static class ProjectResult {
+        private final IncludeResolver.IncludeGraph graph;
+        private final BatchParser.BatchResult batchResult;
+        private final Map<Path, BatchParser.FileResult> files = new LinkedHashMap<>();
+
+        ProjectResult(IncludeResolver.IncludeGraph graph, BatchParser.BatchResult batchResult) {
+            this.graph = graph;
+            this.batchResult = batchResult;
+            for (BatchParser.FileResult file : batchResult.getFiles())
+                files.put(file.getFile(), file);
+        }
+
+        public IncludeResolver.IncludeGraph getGraph() {
+            return graph;
+        }
+
+        /**
+         * One result per file of the graph, headers included.
+         */
+        public BatchParser.BatchResult getBatchResult() {
+            return batchResult;
+        }
+
+        public Map<Path, BatchParser.FileResult> getFiles() {
+            return Collections.unmodifiableMap(files);
+        }
+
+        /**
+         * The result of a file of the graph, or null.
+         */
+        public BatchParser.FileResult getFile(Path file) throws IOException {
+            return files.get(IncludeResolver.canonical(file));
+        }
+
+        /**
+         * The declarations visible in a translation unit: its own followed
+         * by those of its headers in include order. The class and enum
+         * objects are shared with the header models and every other unit
+         * that includes them.
+         */
+        public ApiModel getModel(Path unit) throws IOException {
+            Path file = IncludeResolver.canonical(unit);
+            ApiModel model = new ApiModel();
+            BatchParser.FileResult own = files.get(file);
+            if (own != null)
+                model.merge(own.getModel());
+            for (Path header : graph.transitiveIncludes(file))
+                model.merge(files.get(header).getModel());
+            return model;
+        }
+    }
+}
@@ -0,0 +1,229 @@
+package com.microsoft.calculator;
+
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Deque;
+import java.util.List;
+
+import com.microsoft.CPPCXLexer;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.TokenFactory;
+import org.antlr.v4.runtime.TokenSource;
+
+/**
+ * Drops the tokens inside function bodies so that the parser only sees
+ * {@code {}} for each of them.
+ *
+ * An opening brace starts a body when it follows the end of a declarator: a
+ * {@code )} of a parameter list, a cv/ref qualifier, {@code override},
+ * {@code final}/{@code sealed} after one of those, {@code noexcept},
+ * {@code try}, {@code mutable}, or the {@code ]} of a lambda introducer, a
+ * {@code [} where an operand starts rather than ends. This covers function
+ * definitions, constructors with an initializer list ending in {@code )},
+ * lambdas and property accessors. Class, enum and namespace bodies and brace
+ * initializers, also after an array declarator or a subscript, are passed
+ * through. Everything between the opening brace and its matching closing
+ * brace is skipped and recorded as a {@link SkippedBody}.
+ */
+public class SkipBodyTokenSource implements TokenSource {
+
+    private final TokenSource source;
+    private final List<SkippedBody> skippedBodies = new ArrayList<>();
+    private Token pending;
+    private int previous = Token.INVALID_TYPE;
+    private int beforePrevious = Token.INVALID_TYPE;
+    /** For each open {@code [}, whether it starts a lambda introducer. */
+    private final Deque<Boolean> brackets = new ArrayDeque<>();
+    private boolean lambdaIntroducer;
+
+    public SkipBodyTokenSource(TokenSource source) {
+        this.source = source;
+    }
+
+    /**
+     * Bodies skipped so far, in source order.
+     */
+    public List<SkippedBody> getSkippedBodies() {
+        return Collections.unmodifiableList(skippedBodies);
+    }
+
+    @Override
+    public Token nextToken() {
+        Token token;
+        if (pending != null) {
+            token = pending;
+            pending = null;
+        } else {
+            token = source.nextToken();
+            if (token.getChannel() == Token.DEFAULT_CHANNEL && token.getType() == CPPCXLexer.LeftBrace
+                    && startsBody())
+                skipBody(token);
+        }
+        if (token.getChannel() == Token.DEFAULT_CHANNEL) {
+            if (token.getType() == CPPCXLexer.LeftBracket)
+                brackets.push(startsOperand(previous));
+            else if (token.getType() == CPPCXLexer.RightBracket)
+                lambdaIntroducer = !brackets.isEmpty() && brackets.pop();
+            beforePrevious = previous;
+            previous = token.getType();
+        }
+        return token;
+    }
+
+    private boolean startsBody() {
+        switch (previous) {
+        case CPPCXLexer.RightBracket:
+            // Not "int a[] {" or "y[i] {".
+            return lambdaIntroducer;
+        case CPPCXLexer.RightParen:
+        case CPPCXLexer.Const:
+        case CPPCXLexer.Volatile:
+        case CPPCXLexer.And:
+        case CPPCXLexer.AndAnd:
+        case CPPCXLexer.Override:
+        case CPPCXLexer.Noexcept:
+        case CPPCXLexer.Try:
+        case CPPCXLexer.Mutable:
+            return true;
+        case CPPCXLexer.Final:
+        case CPPCXLexer.Sealed:
+            // "ref class X sealed {" opens a class body.
+            return beforePrevious == CPPCXLexer.RightParen || beforePrevious == CPPCXLexer.Const
+                    || beforePrevious == CPPCXLexer.Volatile || beforePrevious == CPPCXLexer.Override
+                    || beforePrevious == CPPCXLexer.Noexcept;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * Whether an operand starts after the token, so that a {@code [} there
+     * opens a lambda introducer rather than a subscript or array declarator.
+     */
+    private static boolean startsOperand(int type) {
+        switch (type) {
+        case CPPCXLexer.LeftParen:
+        case CPPCXLexer.LeftBrace:
+        case CPPCXLexer.RightBrace:
+        case CPPCXLexer.Semi:
+        case CPPCXLexer.Comma:
+        case CPPCXLexer.Assign:
+        case CPPCXLexer.Question:
+        case CPPCXLexer.Colon:
+        case CPPCXLexer.Not:
+        case CPPCXLexer.AndAnd:
+        case CPPCXLexer.OrOr:
+        case CPPCXLexer.Return:
+        case CPPCXLexer.Throw:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * Reads up to the matching closing brace, which becomes the next token.
+     */
+    private void skipBody(Token open) {
+        int depth = 1;
+        int skipped = 0;
+        while (true) {
+            Token token = source.nextToken();
+            if (token.getType() == Token.EOF) {
+                pending = token;
+                return;
+            }
+            if (token.getChannel() == Token.DEFAULT_CHANNEL) {
+                if (token.getType() == CPPCXLexer.LeftBrace) {
+                    depth++;
+                } else if (token.getType() == CPPCXLexer.RightBrace && --depth == 0) {
+                    pending = token;
+                    skippedBodies.add(new SkippedBody(open, token, skipped));
+                    return;
+                }
+            }
+            skipped++;
+        }
+    }
+
+    @Override
+    public int getLine() {
+        return source.getLine();
+    }
+
+    @Override
+    public int getCharPositionInLine() {
+        return source.getCharPositionInLine();
+    }
+
+    @Override
+    public CharStream getInputStream() {
+        return source.getInputStream();
+    }
+
+    @Override
+    public String getSourceName() {
+        return source.getSourceName();
+    }
+
+    @Override
+    public void setTokenFactory(TokenFactory<?> factory) {
+        source.setTokenFactory(factory);
+    }
+
+    @Override
+    public TokenFactory<?> getTokenFactory() {
+        return source.getTokenFactory();
+    }
+
+    /**
+     * The extent of a body whose contents were skipped. The brace tokens are
+     * the ones the parser sees, so their token indexes are valid once the
+     * token stream has fetched them.
+     */
+    public static class SkippedBody {
+        private final Token open;
+        private final Token close;
+        private final int skippedTokens;
+
+        SkippedBody(Token open, Token close, int skippedTokens) {
+            this.open = open;
+            this.close = close;
+            this.skippedTokens = skippedTokens;
+        }
+
+        public Token getOpen() {
+            return open;
+        }
+
+        public Token getClose() {
+            return close;
+        }
+
+        /**
+         * Number of tokens between the braces, hidden ones included.
+         */
+        public int getSkippedTokens() {
+            return skippedTokens;
+        }
+
+        public int getStartIndex() {
+            return open.getStartIndex();
+        }
+
+        public int getStopIndex() {
+            return close.getStopIndex();
+        }
+
+        public int getStartLine() {
+            return open.getLine();
+        }
+
+        public int getStopLine() {
+            return close.getLine();
+        }
+    }
+}
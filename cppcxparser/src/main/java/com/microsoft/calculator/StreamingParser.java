@@ -0,0 +1,166 @@
+package com.microsoft.calculator;
+
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.io.Reader;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+import com.microsoft.CPPCXParser.DeclarationContext;
+
+import org.antlr.v4.runtime.CommonTokenFactory;
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.TokenSource;
+import org.antlr.v4.runtime.UnbufferedCharStream;
+import org.antlr.v4.runtime.UnbufferedTokenStream;
+
+/**
+ * Parses a file one declaration at a time with unbuffered character and token
+ * streams.
+ *
+ * Top-level declarations are handed to a {@link Handler} as soon as they are
+ * parsed and are not referenced afterwards. Namespace definitions are not
+ * parsed as one declaration: their header and closing brace are matched here
+ * and their members are streamed in turn, so memory is bounded by the largest
+ * declaration outside a namespace body rather than by the file size.
+ */
+public class StreamingParser {
+
+    /**
+     * Receives the declarations of a file in source order.
+     */
+    public interface Handler {
+        /**
+         * A namespace body starts; the name is qualified as written and is
+         * empty for anonymous namespaces.
+         */
+        void enterNamespace(String name);
+
+        void declaration(DeclarationContext declaration);
+
+        void exitNamespace(String name);
+    }
+
+    private final TwoStageParser twoStage;
+    private boolean skipBodies;
+    private MacroTable macros;
+
+    public StreamingParser() {
+        this(new TwoStageParser());
+    }
+
+    public StreamingParser(TwoStageParser twoStage) {
+        this.twoStage = twoStage;
+    }
+
+    /**
+     * Parses function bodies as empty, see {@link SkipBodyTokenSource}.
+     */
+    public void setSkipBodies(boolean skipBodies) {
+        this.skipBodies = skipBodies;
+    }
+
+    /**
+     * Expands the macros of the table before parsing, see
+     * {@link MacroExpandingTokenSource}.
+     */
+    public void setMacros(MacroTable macros) {
+        this.macros = macros;
+    }
+
+    /**
+     * @return the number of syntax errors
+     */
+    public int parse(Path file, Handler handler) throws IOException {
+        try (Reader reader = new InputStreamReader(Files.newInputStream(file), StandardCharsets.UTF_8)) {
+            return parse(reader, file.toString(), handler);
+        }
+    }
+
+    /**
+     * @return the number of syntax errors
+     */
+    public int parse(Reader reader, String sourceName, Handler handler) {
+        UnbufferedCharStream chars = new UnbufferedCharStream(reader);
+        chars.name = sourceName;
+        CPPCXLexer lexer = new CPPCXLexer(chars);
+        // Token text must be copied out before the character buffer moves on.
+        lexer.setTokenFactory(new CommonTokenFactory(true));
+        TokenSource source = lexer;
+        if (macros != null)
+            source = new MacroExpandingTokenSource(source, macros);
+        if (skipBodies)
+            source = new SkipBodyTokenSource(source);
+        UnbufferedTokenStream<Token> tokens = new UnbufferedTokenStream<>(source);
+        CPPCXParser parser = new CPPCXParser(tokens);
+
+        declarations(parser, tokens, handler, false);
+        return parser.getNumberOfSyntaxErrors();
+    }
+
+    private void declarations(CPPCXParser parser, UnbufferedTokenStream<Token> tokens, Handler handler,
+            boolean inNamespace) {
+        while (true) {
+            int next = tokens.LA(1);
+            if (next == Token.EOF) {
+                if (inNamespace)
+                    parser.notifyErrorListeners(tokens.LT(1), "missing '}' at end of namespace", null);
+                return;
+            }
+            if (inNamespace && next == CPPCXParser.RightBrace) {
+                tokens.consume();
+                return;
+            }
+
+            String namespace = namespaceHeader(tokens);
+            if (namespace != null) {
+                handler.enterNamespace(namespace);
+                declarations(parser, tokens, handler, true);
+                handler.exitNamespace(namespace);
+                continue;
+            }
+
+            // The mark keeps the declaration's tokens buffered so that an SLL
+            // failure can be re-parsed with LL.
+            int start = tokens.index();
+            int marker = tokens.mark();
+            DeclarationContext declaration;
+            try {
+                declaration = twoStage.parse(parser, TwoStageParser.DECLARATION);
+            } finally {
+                tokens.release(marker);
+            }
+            if (tokens.index() == start)
+                tokens.consume();
+            else
+                handler.declaration(declaration);
+        }
+    }
+
+    /**
+     * Consumes an {@code inline? namespace name?} header and its opening brace
+     * and returns the name, or returns null without consuming anything if the
+     * next tokens do not start a namespace definition.
+     */
+    private static String namespaceHeader(UnbufferedTokenStream<Token> tokens) {
+        int i = 1;
+        if (tokens.LA(i) == CPPCXParser.Inline)
+            i++;
+        if (tokens.LA(i) != CPPCXParser.Namespace)
+            return null;
+        i++;
+        StringBuilder name = new StringBuilder();
+        while (tokens.LA(i) == CPPCXParser.Identifier || tokens.LA(i) == CPPCXParser.Doublecolon) {
+            name.append(tokens.LT(i).getText());
+            i++;
+        }
+        if (tokens.LA(i) != CPPCXParser.LeftBrace)
+            return null;
+        for (; i > 0; i--)
+            tokens.consume();
+        return name.toString();
+    }
+}
@@ -0,0 +1,285 @@
+package com.microsoft.calculator;
+
+import java.io.IOException;
+import java.nio.file.Path;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Deque;
+import java.util.Iterator;
+import java.util.List;
+
+import com.microsoft.CPPCXLexer;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.Token;
+
+/**
+ * Finds the C++/CX symbols of a file from its tokens alone, without parsing.
+ *
+ * The scanner matches short token patterns:
+ *
+ * <ul>
+ * <li>{@code ref class|struct Name} followed by a class body</li>
+ * <li>{@code enum class|struct Name} followed by an enum body</li>
+ * <li>{@code property Type Name} followed by a brace, semicolon or
+ * bracket</li>
+ * <li>{@code delegate Type Name (}</li>
+ * <li>{@code event Type Name} followed by a semicolon or brace</li>
+ * </ul>
+ *
+ * and tracks namespace and class braces to qualify the names. Forward
+ * declarations are skipped. {@code delegate} and {@code event} are plain
+ * identifiers to the lexer and are recognized by their text. Symbols that
+ * only appear after macro expansion, such as those declared with
+ * {@code PROPERTY_R}, are not found.
+ *
+ * A scanner reuses one lexer and must not be shared between threads.
+ */
+public class SymbolScanner {
+
+    public enum Kind {
+        REF_CLASS("ref class"),
+        ENUM_CLASS("enum class"),
+        PROPERTY("property"),
+        DELEGATE("delegate"),
+        EVENT("event");
+
+        private final String keyword;
+
+        Kind(String keyword) {
+            this.keyword = keyword;
+        }
+
+        @Override
+        public String toString() {
+            return keyword;
+        }
+    }
+
+    private final CPPCXLexer lexer = new CPPCXLexer(CharStreams.fromString(""));
+
+    public SymbolScanner() {
+        lexer.removeErrorListeners();
+    }
+
+    public List<Symbol> scan(Path file) throws IOException {
+        return scan(MappedCharStream.fromPath(file));
+    }
+
+    public List<Symbol> scan(CharStream input) {
+        lexer.setInputStream(input);
+        List<Token> tokens = new ArrayList<>();
+        for (Token token = lexer.nextToken(); token.getType() != Token.EOF; token = lexer.nextToken()) {
+            if (token.getChannel() == Token.DEFAULT_CHANNEL)
+                tokens.add(token);
+        }
+        return new Scan(tokens).run();
+    }
+
+    /**
+     * The state of one scan: the tokens and the names of the open braces.
+     */
+    private static class Scan {
+        private final List<Token> tokens;
+        private final List<Symbol> symbols = new ArrayList<>();
+        private final Deque<String> scopes = new ArrayDeque<>();
+        private int scopeBrace = -1;
+        private String scopeName;
+
+        Scan(List<Token> tokens) {
+            this.tokens = tokens;
+        }
+
+        List<Symbol> run() {
+            for (int i = 0; i < tokens.size(); i++) {
+                Token token = tokens.get(i);
+                switch (token.getType()) {
+                case CPPCXLexer.LeftBrace:
+                    scopes.push(i == scopeBrace ? scopeName : "");
+                    break;
+                case CPPCXLexer.RightBrace:
+                    if (!scopes.isEmpty())
+                        scopes.pop();
+                    break;
+                case CPPCXLexer.Namespace:
+                    namespace(i);
+                    break;
+                case CPPCXLexer.Class:
+                case CPPCXLexer.Struct:
+                case CPPCXLexer.Union:
+                    if (type(i - 1) == CPPCXLexer.Enum)
+                        enumClass(i);
+                    else
+                        classHead(i, type(i - 1) == CPPCXLexer.Ref);
+                    break;
+                case CPPCXLexer.Property:
+                    property(i);
+                    break;
+                case CPPCXLexer.Identifier:
+                    if (token.getText().equals("delegate"))
+                        delegate(i);
+                    else if (token.getText().equals("event"))
+                        event(i);
+                    break;
+                default:
+                    break;
+                }
+            }
+            return symbols;
+        }
+
+        private void namespace(int i) {
+            StringBuilder name = new StringBuilder();
+            int j = i + 1;
+            while (type(j) == CPPCXLexer.Identifier || type(j) == CPPCXLexer.Doublecolon)
+                name.append(tokens.get(j++).getText());
+            if (type(j) == CPPCXLexer.LeftBrace)
+                openScope(j, name.toString());
+        }
+
+        private void classHead(int i, boolean ref) {
+            if (type(i + 1) != CPPCXLexer.Identifier)
+                return;
+            int body = classBody(i + 2);
+            if (body < 0)
+                return;
+            Token name = tokens.get(i + 1);
+            openScope(body, name.getText());
+            if (ref)
+                add(Kind.REF_CLASS, name);
+        }
+
+        private void enumClass(int i) {
+            if (type(i + 1) == CPPCXLexer.Identifier && classBody(i + 2) >= 0)
+                add(Kind.ENUM_CLASS, tokens.get(i + 1));
+        }
+
+        private void property(int i) {
+            int end = next(i + 1, CPPCXLexer.LeftBrace, CPPCXLexer.Semi, CPPCXLexer.LeftBracket);
+            if (end > i + 2 && (type(end - 1) == CPPCXLexer.Identifier || type(end - 1) == CPPCXLexer.Default))
+                add(Kind.PROPERTY, tokens.get(end - 1));
+        }
+
+        private void delegate(int i) {
+            int end = next(i + 1, CPPCXLexer.LeftParen, CPPCXLexer.Semi, CPPCXLexer.LeftBrace);
+            if (end > i + 2 && type(end) == CPPCXLexer.LeftParen && type(end - 1) == CPPCXLexer.Identifier)
+                add(Kind.DELEGATE, tokens.get(end - 1));
+        }
+
+        private void event(int i) {
+            int end = next(i + 1, CPPCXLexer.Semi, CPPCXLexer.LeftBrace, CPPCXLexer.LeftParen);
+            if (end > i + 2 && type(end) != CPPCXLexer.LeftParen && type(end - 1) == CPPCXLexer.Identifier)
+                add(Kind.EVENT, tokens.get(end - 1));
+        }
+
+        /**
+         * The index of the brace that opens a class or enum body whose name
+         * ends before {@code from}, or -1 for a forward declaration or a
+         * {@code class} keyword in a template parameter, parameter list or
+         * elaborated type specifier.
+         */
+        private int classBody(int from) {
+            for (int j = from; j < tokens.size(); j++) {
+                switch (type(j)) {
+                case CPPCXLexer.LeftBrace:
+                    return j;
+                case CPPCXLexer.Semi:
+                case CPPCXLexer.LeftParen:
+                case CPPCXLexer.RightParen:
+                case CPPCXLexer.Class:
+                case CPPCXLexer.Struct:
+                case CPPCXLexer.RightBrace:
+                    return -1;
+                default:
+                    break;
+                }
+            }
+            return -1;
+        }
+
+        /**
+         * The index of the first of the token types from {@code from} on, or
+         * -1.
+         */
+        private int next(int from, int... types) {
+            for (int j = from; j < tokens.size(); j++) {
+                for (int type : types) {
+                    if (type(j) == type)
+                        return j;
+                }
+            }
+            return -1;
+        }
+
+        private int type(int i) {
+            return i >= 0 && i < tokens.size() ? tokens.get(i).getType() : Token.INVALID_TYPE;
+        }
+
+        private void openScope(int brace, String name) {
+            scopeBrace = brace;
+            scopeName = name;
+        }
+
+        private void add(Kind kind, Token name) {
+            symbols.add(new Symbol(kind, currentScope(), name.getText(), name.getLine()));
+        }
+
+        private String currentScope() {
+            StringBuilder sb = new StringBuilder();
+            Iterator<String> outermostFirst = scopes.descendingIterator();
+            while (outermostFirst.hasNext()) {
+                String scope = outermostFirst.next();
+                if (scope.isEmpty())
+                    continue;
+                if (sb.length() > 0)
+                    sb.append("::");
+                sb.append(scope);
+            }
+            return sb.toString();
+        }
+    }
+
+    /**
+     * A symbol found by the scanner. The scope is that of the enclosing
+     * namespaces and classes.
+     */
+    public static class Symbol {
+        private final Kind kind;
+        private final String scope;
+        private final String name;
+        private final int line;
+
+        Symbol(Kind kind, String scope, String name, int line) {
+            this.kind = kind;
+            this.scope = scope;
+            this.name = name;
+            this.line = line;
+        }
+
+        public Kind getKind() {
+            return kind;
+        }
+
+        public String getScope() {
+            return scope;
+        }
+
+        public String getName() {
+            return name;
+        }
+
+        public String getQualifiedName() {
+            return ApiModel.qualify(scope, name);
+        }
+
+        public int getLine() {
+            return line;
+        }
+
+        @Override
+        public String toString() {
+            return line + ": " + kind + " " + getQualifiedName();
+        }
+    }
+}
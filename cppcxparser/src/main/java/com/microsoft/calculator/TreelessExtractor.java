@@ -0,0 +1,236 @@
+package com.microsoft.calculator;
+
+import java.util.ArrayDeque;
+import java.util.Deque;
+
+import com.microsoft.CPPCXParser;
+import com.microsoft.CPPCXParser.ClassSpecifierContext;
+import com.microsoft.CPPCXParser.EnumSpecifierContext;
+import com.microsoft.CPPCXParser.NamespaceDefinitionContext;
+import com.microsoft.CPPCXParser.PropertyDefinitionContext;
+
+import org.antlr.v4.runtime.ParserRuleContext;
+import org.antlr.v4.runtime.tree.ErrorNode;
+import org.antlr.v4.runtime.tree.ParseTreeListener;
+import org.antlr.v4.runtime.tree.TerminalNode;
+
+/**
+ * Extracts the {@link ApiModel} while the parser runs, without building
+ * the parse tree.
+ *
+ * The extractor is a parse listener on a parser that does not build trees,
+ * so every context is garbage once its rule returns. Only the heads of the
+ * API declarations are kept as trees: the attribute, access and head of a
+ * class specifier, the head and enumerators of an enum specifier, the type
+ * and declarator of a property definition and the name of a namespace
+ * definition. All other rules are not retained, function bodies and
+ * expressions included. The {@link CxListener} is called with the
+ * declaration once its head is complete, so it sees the same contexts as in
+ * a full tree, and a declaration only counts where an
+ * {@link ApiModelBuilder} would visit it.
+ *
+ * A parse starting at the root rule starts a new model, so the parse
+ * attempts of a {@link TwoStageParser} leave only the last model. One
+ * extractor per parser.
+ */
+public class TreelessExtractor implements ParseTreeListener {
+
+    private final CPPCXParser parser;
+    private final Deque<Declaration> declarations = new ArrayDeque<>();
+    private CxListener listener = new CxListener();
+    private ParserRuleContext kept;
+
+    /**
+     * Makes the parser stop building trees and extract with this instead.
+     */
+    public TreelessExtractor(CPPCXParser parser) {
+        this.parser = parser;
+        parser.setBuildParseTree(false);
+        parser.addParseListener(this);
+    }
+
+    /**
+     * Makes the parser build trees again.
+     */
+    public void detach() {
+        parser.removeParseListener(this);
+        parser.setBuildParseTree(true);
+    }
+
+    /**
+     * The model of the last parse.
+     */
+    public ApiModel getModel() {
+        return listener.getModel();
+    }
+
+    @Override
+    public void enterEveryRule(ParserRuleContext ctx) {
+        if (kept != null)
+            return;
+        ParserRuleContext parent = ctx.getParent();
+        if (parent == null) {
+            reset();
+            return;
+        }
+        Declaration top = declarations.peek();
+        if (top != null && parent == top.ctx && !top.entered) {
+            if (isHead(parent.getRuleIndex(), ctx.getRuleIndex())) {
+                parent.addChild(ctx);
+                kept = ctx;
+                parser.setBuildParseTree(true);
+                return;
+            }
+            top.enter(listener);
+        }
+        if (isDeclaration(ctx.getRuleIndex()) && isVisited(ctx))
+            declarations.push(new Declaration(ctx));
+    }
+
+    @Override
+    public void exitEveryRule(ParserRuleContext ctx) {
+        if (ctx == kept) {
+            kept = null;
+            parser.setBuildParseTree(false);
+            return;
+        }
+        if (kept != null)
+            return;
+        Declaration top = declarations.peek();
+        if (top != null && ctx == top.ctx) {
+            declarations.pop();
+            if (!top.entered)
+                top.enter(listener);
+            top.exit(listener);
+        }
+    }
+
+    @Override
+    public void visitTerminal(TerminalNode node) {
+    }
+
+    @Override
+    public void visitErrorNode(ErrorNode node) {
+    }
+
+    private void reset() {
+        declarations.clear();
+        kept = null;
+        parser.setBuildParseTree(false);
+        listener = new CxListener();
+    }
+
+    private static boolean isDeclaration(int rule) {
+        return rule == CPPCXParser.RULE_namespaceDefinition || rule == CPPCXParser.RULE_classSpecifier
+                || rule == CPPCXParser.RULE_enumSpecifier || rule == CPPCXParser.RULE_propertyDefinition;
+    }
+
+    /**
+     * Whether the child of the declaration is part of its head, which the
+     * {@link CxListener} reads.
+     */
+    private static boolean isHead(int declaration, int child) {
+        switch (declaration) {
+        case CPPCXParser.RULE_namespaceDefinition:
+            return child == CPPCXParser.RULE_qualifiednamespacespecifier;
+        case CPPCXParser.RULE_classSpecifier:
+            return child == CPPCXParser.RULE_cxAttribute || child == CPPCXParser.RULE_accessSpecifier
+                    || child == CPPCXParser.RULE_classHead;
+        case CPPCXParser.RULE_enumSpecifier:
+            return child == CPPCXParser.RULE_enumHead || child == CPPCXParser.RULE_enumeratorList;
+        case CPPCXParser.RULE_propertyDefinition:
+            return child == CPPCXParser.RULE_declSpecifier || child == CPPCXParser.RULE_memberDeclarator;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * Whether an {@link ApiModelBuilder} on the tree would reach the
+     * context, checked through its parents.
+     */
+    private static boolean isVisited(ParserRuleContext ctx) {
+        for (ParserRuleContext parent = ctx.getParent(); parent != null; ctx = parent, parent = parent.getParent()) {
+            if (!isVisited(parent.getRuleIndex(), ctx.getRuleIndex()))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * Whether {@link ApiModelBuilder} visits a child of the rule from a
+     * context of the parent rule.
+     */
+    private static boolean isVisited(int parent, int child) {
+        switch (parent) {
+        case CPPCXParser.RULE_translationUnit:
+        case CPPCXParser.RULE_declarationseq:
+        case CPPCXParser.RULE_declaration:
+        case CPPCXParser.RULE_blockDeclaration:
+        case CPPCXParser.RULE_linkageSpecification:
+            return true;
+        case CPPCXParser.RULE_simpleDeclaration:
+        case CPPCXParser.RULE_functionDefinition:
+            return child == CPPCXParser.RULE_declSpecifierSeq;
+        case CPPCXParser.RULE_declSpecifierSeq:
+            return child == CPPCXParser.RULE_declSpecifier;
+        case CPPCXParser.RULE_declSpecifier:
+            return child == CPPCXParser.RULE_typeSpecifier;
+        case CPPCXParser.RULE_typeSpecifier:
+            return child == CPPCXParser.RULE_classSpecifier || child == CPPCXParser.RULE_enumSpecifier;
+        case CPPCXParser.RULE_templateDeclaration:
+        case CPPCXParser.RULE_explicitInstantiation:
+        case CPPCXParser.RULE_explicitSpecialization:
+            return child == CPPCXParser.RULE_declaration;
+        case CPPCXParser.RULE_namespaceDefinition:
+            return child == CPPCXParser.RULE_declarationseq;
+        case CPPCXParser.RULE_classSpecifier:
+            return child == CPPCXParser.RULE_memberSpecification;
+        case CPPCXParser.RULE_memberSpecification:
+            return child == CPPCXParser.RULE_memberdeclaration;
+        case CPPCXParser.RULE_memberdeclaration:
+            return child == CPPCXParser.RULE_declSpecifierSeq || child == CPPCXParser.RULE_functionDefinition
+                    || child == CPPCXParser.RULE_propertyDefinition || child == CPPCXParser.RULE_templateDeclaration;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * A declaration being parsed, entered into the listener once its head
+     * is complete.
+     */
+    private static class Declaration {
+        final ParserRuleContext ctx;
+        boolean entered;
+
+        Declaration(ParserRuleContext ctx) {
+            this.ctx = ctx;
+        }
+
+        void enter(CxListener listener) {
+            entered = true;
+            switch (ctx.getRuleIndex()) {
+            case CPPCXParser.RULE_namespaceDefinition:
+                listener.enterNamespaceDefinition((NamespaceDefinitionContext) ctx);
+                break;
+            case CPPCXParser.RULE_classSpecifier:
+                listener.enterClassSpecifier((ClassSpecifierContext) ctx);
+                break;
+            case CPPCXParser.RULE_enumSpecifier:
+                listener.enterEnumSpecifier((EnumSpecifierContext) ctx);
+                break;
+            default:
+                listener.enterPropertyDefinition((PropertyDefinitionContext) ctx);
+                break;
+            }
+        }
+
+        void exit(CxListener listener) {
+            if (ctx.getRuleIndex() == CPPCXParser.RULE_namespaceDefinition)
+                listener.exitNamespaceDefinition((NamespaceDefinitionContext) ctx);
+            else if (ctx.getRuleIndex() == CPPCXParser.RULE_classSpecifier)
+                listener.exitClassSpecifier((ClassSpecifierContext) ctx);
+        }
+    }
+}
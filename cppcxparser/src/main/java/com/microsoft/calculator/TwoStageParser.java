@@ -0,0 +1,144 @@
+package com.microsoft.calculator;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.atomic.AtomicLong;
+
+import com.microsoft.CPPCXParser;
+import com.microsoft.CPPCXParser.DeclarationContext;
+import com.microsoft.CPPCXParser.DeclarationseqContext;
+import com.microsoft.CPPCXParser.MemberdeclarationContext;
+import com.microsoft.CPPCXParser.TranslationUnitContext;
+
+import org.antlr.v4.runtime.ANTLRErrorListener;
+import org.antlr.v4.runtime.ANTLRErrorStrategy;
+import org.antlr.v4.runtime.BailErrorStrategy;
+import org.antlr.v4.runtime.Parser;
+import org.antlr.v4.runtime.ParserRuleContext;
+import org.antlr.v4.runtime.RecognitionException;
+import org.antlr.v4.runtime.TokenStream;
+import org.antlr.v4.runtime.atn.PredictionMode;
+import org.antlr.v4.runtime.misc.ParseCancellationException;
+
+/**
+ * Parses with SLL prediction first and re-parses with full LL only when SLL
+ * fails.
+ *
+ * SLL never accepts invalid input, but it may reject valid input, so an SLL
+ * failure is not reported: the rule is re-parsed with the parser's own error
+ * strategy and listeners, which then report genuine syntax errors. A
+ * {@link ParseTimeoutException} ends the parse in either stage. The
+ * counters are safe to share between threads.
+ */
+public class TwoStageParser {
+
+    /**
+     * The rule a parse starts from.
+     */
+    public interface StartRule<T extends ParserRuleContext> {
+        T invoke(CPPCXParser parser);
+    }
+
+    public static final StartRule<TranslationUnitContext> TRANSLATION_UNIT = new StartRule<TranslationUnitContext>() {
+        @Override
+        public TranslationUnitContext invoke(CPPCXParser parser) {
+            return parser.translationUnit();
+        }
+    };
+
+    public static final StartRule<DeclarationContext> DECLARATION = new StartRule<DeclarationContext>() {
+        @Override
+        public DeclarationContext invoke(CPPCXParser parser) {
+            return parser.declaration();
+        }
+    };
+
+    public static final StartRule<DeclarationseqContext> DECLARATION_SEQ = new StartRule<DeclarationseqContext>() {
+        @Override
+        public DeclarationseqContext invoke(CPPCXParser parser) {
+            return parser.declarationseq();
+        }
+    };
+
+    public static final StartRule<MemberdeclarationContext> MEMBER_DECLARATION = new StartRule<MemberdeclarationContext>() {
+        @Override
+        public MemberdeclarationContext invoke(CPPCXParser parser) {
+            return parser.memberdeclaration();
+        }
+    };
+
+    private final AtomicLong parseCount = new AtomicLong();
+    private final AtomicLong fallbackCount = new AtomicLong();
+
+    public TranslationUnitContext parse(CPPCXParser parser) {
+        return parse(parser, TRANSLATION_UNIT);
+    }
+
+    public <T extends ParserRuleContext> T parse(CPPCXParser parser, StartRule<T> rule) {
+        parseCount.incrementAndGet();
+
+        // LA(1) initializes a fresh token stream so that index() can be seeked back to.
+        TokenStream input = parser.getInputStream();
+        input.LA(1);
+        int start = input.index();
+
+        PredictionMode mode = parser.getInterpreter().getPredictionMode();
+        ANTLRErrorStrategy errorHandler = parser.getErrorHandler();
+        List<ANTLRErrorListener> errorListeners = new ArrayList<ANTLRErrorListener>(parser.getErrorListeners());
+
+        parser.getInterpreter().setPredictionMode(PredictionMode.SLL);
+        parser.setErrorHandler(new SilentBailErrorStrategy());
+        parser.removeErrorListeners();
+        try {
+            return rule.invoke(parser);
+        } catch (ParseTimeoutException e) {
+            throw e;
+        } catch (ParseCancellationException e) {
+            fallbackCount.incrementAndGet();
+        } finally {
+            parser.getInterpreter().setPredictionMode(mode);
+            parser.setErrorHandler(errorHandler);
+            for (ANTLRErrorListener listener : errorListeners) {
+                parser.addErrorListener(listener);
+            }
+        }
+
+        input.seek(start);
+        errorHandler.reset(parser);
+        parser.getInterpreter().setPredictionMode(mode == PredictionMode.SLL ? PredictionMode.LL : mode);
+        try {
+            return rule.invoke(parser);
+        } finally {
+            parser.getInterpreter().setPredictionMode(mode);
+        }
+    }
+
+    /**
+     * Number of rules parsed.
+     */
+    public long getParseCount() {
+        return parseCount.get();
+    }
+
+    /**
+     * Number of parses where SLL failed and the rule was re-parsed with LL.
+     */
+    public long getFallbackCount() {
+        return fallbackCount.get();
+    }
+
+    @Override
+    public String toString() {
+        return "parses: " + getParseCount() + ", LL fallbacks: " + getFallbackCount();
+    }
+
+    /**
+     * Bails out without reporting, so that an SLL failure does not count as
+     * a syntax error of the parser.
+     */
+    private static final class SilentBailErrorStrategy extends BailErrorStrategy {
+        @Override
+        public void reportError(Parser recognizer, RecognitionException e) {
+        }
+    }
+}
@@ -0,0 +1,84 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.IOException;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.List;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.junit.Test;
+
+public class ApiIndexTest {
+
+    private static final Path MIN = Paths.get("min.cpp");
+    private static final Path OTHER = Paths.get("other.cpp");
+
+    private static ApiModel model(CharStream input) {
+        CPPCXParser parser = new CPPCXParser(new CommonTokenStream(new CPPCXLexer(input)));
+        return ApiModelBuilder.build(new TwoStageParser().parse(parser));
+    }
+
+    private static ApiIndex index() throws IOException {
+        ApiIndex index = new ApiIndex();
+        index.put(MIN, model(CharStreams.fromStream(ApiIndexTest.class.getResourceAsStream("/min.cpp"))));
+        index.put(OTHER, model(CharStreams.fromString(
+                "namespace CalculatorApp { namespace Common { [Windows::UI::Xaml::Data::Bindable]"
+                        + " public ref class Item sealed : INotifyPropertyChanged"
+                        + " { property Platform::String^ Text { Platform::String^ get() { return nullptr; } } };"
+                        + " enum class Mode { A, B }; } }")));
+        return index;
+    }
+
+    @Test
+    public void looksUpByQualifiedAndShortNames() throws IOException {
+        ApiIndex index = index();
+
+        List<ApiModel.ClassInfo> bindable = index.getClassesWithAttribute("Bindable");
+        assertEquals(2, bindable.size());
+        assertEquals("CalculatorApp::NavCategory", bindable.get(0).getQualifiedName());
+        assertEquals("CalculatorApp::Common::Item", bindable.get(1).getQualifiedName());
+        assertEquals(2, index.getClassesWithAttribute("Windows::UI::Xaml::Data::Bindable").size());
+
+        assertEquals(2, index.getClassesWithBase("INotifyPropertyChanged").size());
+        assertEquals(1, index.getClassesWithBase("Windows::UI::Xaml::Data::INotifyPropertyChanged").size());
+
+        List<ApiIndex.Property> strings = index.getPropertiesOfType("Platform::String ^");
+        assertEquals(2, strings.size());
+        assertEquals("AutomationId", strings.get(0).getProperty().getName());
+        assertEquals("CalculatorApp::NavCategory", strings.get(0).getOwner().getQualifiedName());
+        assertEquals("Text", strings.get(1).getProperty().getName());
+
+        assertEquals(1, index.getClassesIn("CalculatorApp").size());
+        assertEquals(1, index.getEnumsIn("CalculatorApp::Common").size());
+        assertEquals(OTHER, index.getFile(index.getEnums("CalculatorApp::Common::Mode").get(0)));
+        assertTrue(index.getClassesWithBase("IDisposable").isEmpty());
+    }
+
+    @Test
+    public void replacesAndRemovesFiles() throws IOException {
+        ApiIndex index = index();
+        ApiModel.ClassInfo item = index.getClasses("CalculatorApp::Common::Item").get(0);
+
+        index.put(OTHER, model(CharStreams.fromString("namespace CalculatorApp { ref class Plain {}; }")));
+        assertEquals(1, index.getClassesWithAttribute("Bindable").size());
+        assertEquals(1, index.getPropertiesOfType("String^").size());
+        assertEquals(2, index.getClassesIn("CalculatorApp").size());
+        assertTrue(index.getEnumsIn("CalculatorApp::Common").isEmpty());
+        assertNull(index.getFile(item));
+
+        assertTrue(index.remove(MIN));
+        assertFalse(index.remove(MIN));
+        assertTrue(index.getClassesWithAttribute("Bindable").isEmpty());
+        assertEquals(1, index.getFiles().size());
+    }
+}
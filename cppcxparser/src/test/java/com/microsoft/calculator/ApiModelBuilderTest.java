@@ -0,0 +1,63 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.List;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+import com.microsoft.CPPCXParser.TranslationUnitContext;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.tree.ParseTreeWalker;
+import org.junit.Test;
+
+public class ApiModelBuilderTest {
+
+    private static TranslationUnitContext parse(CharStream input) {
+        CPPCXParser parser = new CPPCXParser(new CommonTokenStream(new CPPCXLexer(input)));
+        return new TwoStageParser().parse(parser);
+    }
+
+    @Test
+    public void buildsSameModelAsWalk() throws IOException {
+        TranslationUnitContext tu = parse(CharStreams.fromStream(getClass().getResourceAsStream("/example.cpp")));
+        CxListener listener = new CxListener();
+        ParseTreeWalker.DEFAULT.walk(listener, tu);
+
+        ApiModel walked = listener.getModel();
+        ApiModel built = ApiModelBuilder.build(tu);
+
+        assertEquals(describe(walked), describe(built));
+    }
+
+    @Test
+    public void skipsFunctionBodies() {
+        ApiModel model = ApiModelBuilder.build(parse(CharStreams.fromString(
+                "namespace N { ref class A { property int X { int get() { return 0; } }"
+                        + " void f() { struct Local {}; } }; template <typename T> struct B {}; }\n"
+                        + "void g() { enum E { Z }; }")));
+
+        assertEquals(2, model.getClasses().size());
+        assertEquals("N::A", model.getClasses().get(0).getQualifiedName());
+        assertEquals("X", model.getClasses().get(0).getProperties().get(0).getName());
+        assertEquals("N::B", model.getClasses().get(1).getQualifiedName());
+        assertEquals(0, model.getEnums().size());
+    }
+
+    private static List<String> describe(ApiModel model) {
+        List<String> lines = new ArrayList<>();
+        for (ApiModel.ClassInfo cls : model.getClasses()) {
+            lines.add(cls.toString());
+            for (ApiModel.PropertyInfo property : cls.getProperties())
+                lines.add("  " + property);
+        }
+        for (ApiModel.EnumInfo e : model.getEnums())
+            lines.add(e.toString());
+        return lines;
+    }
+}
@@ -0,0 +1,103 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Collections;
+import java.util.List;
+
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+public class BatchParserTest {
+
+    @Rule
+    public TemporaryFolder folder = new TemporaryFolder();
+
+    @Test
+    public void parsesSourcesBelowDirectoryInOrder() throws IOException, InterruptedException {
+        Path root = folder.getRoot().toPath();
+        Files.createDirectories(root.resolve("sub"));
+        try (InputStream is = getClass().getResourceAsStream("/min.cpp")) {
+            Files.copy(is, root.resolve("sub/b.h"));
+        }
+        Files.write(root.resolve("a.cpp"), "ref class A {};".getBytes("UTF-8"));
+        Files.write(root.resolve("notes.txt"), "not c++".getBytes("UTF-8"));
+
+        List<Path> files = BatchParser.collectSources(Collections.singletonList(root));
+        assertEquals(2, files.size());
+
+        BatchParser.BatchResult result = new BatchParser(2).parse(files);
+
+        assertEquals(0, result.getFailureCount());
+        assertNull(result.getFiles().get(0).getFailure());
+        assertEquals("A", result.getFiles().get(0).getModel().getClasses().get(0).getName());
+        assertEquals(2, result.getModel().getRefClasses().size());
+    }
+
+    @Test
+    public void pooledTokensGiveSameModels() throws IOException, InterruptedException {
+        Path root = folder.getRoot().toPath();
+        Files.write(root.resolve("a.cpp"), "ref class A { property Platform::String^ Name; };".getBytes("UTF-8"));
+        Files.write(root.resolve("b.cpp"), "ref class B { property Platform::String^ Name; };".getBytes("UTF-8"));
+        List<Path> files = BatchParser.collectSources(Collections.singletonList(root));
+
+        BatchParser batch = new BatchParser(1);
+        batch.setPoolTokens(true);
+        BatchParser.BatchResult result = batch.parse(files);
+
+        assertEquals("property Platform::String^ Name",
+                result.getFiles().get(1).getModel().getClasses().get(0).getProperties().get(0).toString());
+        InterningTokenFactory.Counts counts = batch.getTokenCounts();
+        // One worker: b.cpp lexes into the tokens of a.cpp and all its texts but B are known.
+        assertEquals(counts.getCreated(), counts.getReused());
+        assertTrue(counts.getInternHits() >= 12);
+    }
+
+    @Test
+    public void pooledTokensDoNotLeakIntoCachedExpansions() throws IOException, InterruptedException {
+        Path root = folder.getRoot().toPath();
+        Files.write(root.resolve("a.cpp"), "ref class A { PROPERTY_R(int, Count); };".getBytes("UTF-8"));
+        Files.write(root.resolve("b.cpp"), "ref class B { bool x; double y; PROPERTY_R(int, Count); };"
+                .getBytes("UTF-8"));
+        List<Path> files = BatchParser.collectSources(Collections.singletonList(root));
+
+        BatchParser batch = new BatchParser(1);
+        batch.setPoolTokens(true);
+        batch.setMacros(MacroTable.calculatorDefaults());
+        BatchParser.BatchResult result = batch.parse(files);
+
+        assertEquals(0, result.getSyntaxErrorCount());
+        for (int i = 0; i < 2; i++) {
+            ApiModel.PropertyInfo property = result.getFiles().get(i).getModel().getClasses().get(0)
+                    .getProperties().get(0);
+            assertEquals("Count", property.getName());
+            assertEquals("int", property.getType());
+        }
+    }
+
+    @Test
+    public void filesReadIntoTheHeapGiveSameModels() throws IOException, InterruptedException {
+        Path root = folder.getRoot().toPath();
+        Files.write(root.resolve("a.cpp"), "ref class A { property Platform::String^ Name; };".getBytes("UTF-8"));
+        List<Path> files = BatchParser.collectSources(Collections.singletonList(root));
+
+        BatchParser batch = new BatchParser(1);
+        batch.setPoolTokens(true);
+        batch.setMapFiles(false);
+        BatchParser.BatchResult result = batch.parse(files);
+        // Nothing refers to the file any more, so it can be replaced at once.
+        Files.write(root.resolve("a.cpp"), "ref class B {};".getBytes("UTF-8"));
+
+        assertEquals(0, result.getSyntaxErrorCount());
+        assertEquals("property Platform::String^ Name",
+                result.getFiles().get(0).getModel().getClasses().get(0).getProperties().get(0).toString());
+        assertEquals("B", batch.parse(files).getFiles().get(0).getModel().getClasses().get(0).getName());
+    }
+}
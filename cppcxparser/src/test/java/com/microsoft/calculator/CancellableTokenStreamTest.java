@@ -0,0 +1,46 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+import com.microsoft.CPPCXParser.TranslationUnitContext;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.junit.Test;
+
+public class CancellableTokenStreamTest {
+
+    @Test
+    public void cancelledParseFailsWithoutFallback() {
+        CancellableTokenStream tokens = new CancellableTokenStream(
+                new CPPCXLexer(CharStreams.fromString("ref class A {};", "a.cpp")));
+        CPPCXParser parser = new CPPCXParser(tokens);
+        TwoStageParser twoStage = new TwoStageParser();
+        tokens.cancel();
+
+        try {
+            twoStage.parse(parser);
+            fail("expected a timeout");
+        } catch (ParseTimeoutException e) {
+            assertTrue(e.isCancelled());
+            assertEquals("a.cpp", e.getSourceName());
+        }
+        assertEquals(0, twoStage.getFallbackCount());
+    }
+
+    @Test
+    public void setTimeoutClearsCancellation() {
+        CancellableTokenStream tokens = new CancellableTokenStream(
+                new CPPCXLexer(CharStreams.fromString("ref class A {};")));
+        tokens.cancel();
+        tokens.setTimeout(0);
+
+        TranslationUnitContext tu = new TwoStageParser().parse(new CPPCXParser(tokens));
+
+        assertNotNull(tu.EOF());
+    }
+}
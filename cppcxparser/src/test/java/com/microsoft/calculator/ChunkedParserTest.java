@@ -0,0 +1,103 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.Token;
+import org.junit.After;
+import org.junit.Test;
+
+public class ChunkedParserTest {
+
+    private final ExecutorService executor = Executors.newFixedThreadPool(4);
+
+    @After
+    public void shutDown() {
+        executor.shutdownNow();
+    }
+
+    @Test
+    public void splitsAtDeclarationsAndNamespaces() {
+        List<String> segments = new ArrayList<>();
+        for (ChunkedParser.Segment segment : ChunkedParser.split(tokens(
+                "int a; void f() { } namespace N { auto g = [] () { }; struct S { } s; } extern \"C\" { }"), 1))
+            segments.add(segment.kind + (segment.name == null ? "" : " " + segment.name));
+
+        assertEquals("[CHUNK, CHUNK, ENTER N, CHUNK, CHUNK, EXIT N, CHUNK]", segments.toString());
+    }
+
+    @Test
+    public void unbalancedNamespaceIsNotSplit() {
+        assertEquals(null, ChunkedParser.split(tokens("namespace N { int a;"), 1));
+        assertEquals(null, ChunkedParser.split(tokens("int a; }"), 1));
+    }
+
+    @Test
+    public void parsesChunksInSourceOrder() throws InterruptedException {
+        StringBuilder text = new StringBuilder("namespace App {\n");
+        for (int i = 0; i < 40; i++) {
+            text.append("ref class C").append(i).append(" { property int X { int get() { return ").append(i)
+                    .append("; } } };\n");
+            text.append("int f").append(i).append("(int a) { return a * ").append(i).append("; }\n");
+            if (i % 10 == 0)
+                text.append("namespace Inner { enum class E").append(i).append(" { A, B }; }\n");
+        }
+        text.append("}\n");
+        CPPCXParser parser = new CPPCXParser(new CommonTokenStream(new CPPCXLexer(CharStreams.fromString(
+                text.toString()))));
+        ApiModel whole = ApiModelBuilder.build(new TwoStageParser().parse(parser));
+
+        ChunkedParser chunked = new ChunkedParser(executor, new TwoStageParser());
+        chunked.setChunkTokens(50);
+        List<Token> tokens = tokens(text.toString());
+        CxListener listener = new CxListener();
+
+        assertTrue(chunked.parse(tokens, listener));
+        assertEquals(whole.getClasses().toString(), listener.getModel().getClasses().toString());
+        assertEquals(whole.getEnums().toString(), listener.getModel().getEnums().toString());
+        assertEquals("App::Inner::E30", listener.getModel().getEnums().get(3).getQualifiedName());
+        for (int i = 0; i < tokens.size(); i++)
+            assertEquals(i, tokens.get(i).getTokenIndex());
+    }
+
+    @Test
+    public void chunkWithErrorIsNotHandled() throws InterruptedException {
+        ChunkedParser chunked = new ChunkedParser(executor, new TwoStageParser());
+        chunked.setChunkTokens(1);
+        CxListener listener = new CxListener();
+
+        assertFalse(chunked.parse(tokens("ref class A { }; int b = ; ref class C { };"), listener));
+        assertTrue(listener.getModel().isEmpty());
+    }
+
+    @Test(expected = ParseTimeoutException.class)
+    public void chunksKeepTheFileDeadline() throws InterruptedException {
+        StringBuilder text = new StringBuilder();
+        for (int i = 0; i < 400; i++)
+            text.append("int f").append(i).append("(int a) { return a * ").append(i).append(" + (a - 1); }\n");
+        CancellableTokenStream file = new CancellableTokenStream(new CPPCXLexer(CharStreams.fromString("")));
+        file.setTimeout(1);
+        Thread.sleep(10);
+
+        ChunkedParser chunked = new ChunkedParser(executor, new TwoStageParser());
+        chunked.setChunkTokens(2 * CancellableTokenStream.CHECK_INTERVAL);
+        chunked.parse(tokens(text.toString()), new CxListener(), file);
+    }
+
+    private static List<Token> tokens(String text) {
+        CommonTokenStream tokens = new CommonTokenStream(new CPPCXLexer(CharStreams.fromString(text)));
+        tokens.fill();
+        return tokens.getTokens();
+    }
+}
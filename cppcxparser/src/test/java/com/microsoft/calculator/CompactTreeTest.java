@@ -0,0 +1,57 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.fail;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Arrays;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+import com.microsoft.CPPCXParser.TranslationUnitContext;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+public class CompactTreeTest {
+
+    @Rule
+    public TemporaryFolder folder = new TemporaryFolder();
+
+    @Test
+    public void mappedTreeMatchesParseTree() throws IOException {
+        CPPCXParser parser;
+        try (InputStream is = getClass().getResourceAsStream("/example.cpp")) {
+            parser = new CPPCXParser(new CommonTokenStream(new CPPCXLexer(CharStreams.fromStream(is))));
+        }
+        TranslationUnitContext tu = parser.translationUnit();
+        Path file = folder.getRoot().toPath().resolve("example.tree");
+        CompactTree.of(tu).write(file);
+
+        CompactTree tree = CompactTree.map(file);
+        assertEquals(tu.toStringTree(parser), tree.toStringTree(Arrays.asList(parser.getRuleNames())));
+        assertEquals(tu.getText(), tree.getText(0));
+        assertEquals(CPPCXParser.RULE_translationUnit, tree.getRuleIndex(0));
+
+        assertEquals(tu.getStart().getType(), tree.getTokenTypeAt(0));
+        assertEquals(tu.getStart().getLine(), tree.getTokenLine(0));
+        assertEquals(tu.getStart().getStartIndex(), tree.getTokenStartIndex(0));
+    }
+
+    @Test
+    public void rejectsDamagedFile() throws IOException {
+        Path file = folder.getRoot().toPath().resolve("damaged.tree");
+        Files.write(file, new byte[] { 0x43, 0x58, 0x54, 0x52, 0, 0 });
+        try {
+            CompactTree.map(file);
+            fail();
+        } catch (IOException expected) {
+        }
+    }
+}
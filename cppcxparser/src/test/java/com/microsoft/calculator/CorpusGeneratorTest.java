@@ -0,0 +1,54 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+public class CorpusGeneratorTest {
+
+    @Rule
+    public TemporaryFolder folder = new TemporaryFolder();
+
+    @Test
+    public void writesParsableDeterministicFiles() throws IOException, InterruptedException {
+        CorpusGenerator generator = new CorpusGenerator(7);
+        generator.setFileBytes(8 * 1024);
+        Path root = folder.getRoot().toPath();
+        List<Path> files = generator.write(root, 40 * 1024);
+
+        long bytes = 0;
+        for (Path file : files) {
+            assertTrue(Files.size(file) >= 8 * 1024);
+            bytes += Files.size(file);
+        }
+        assertTrue(bytes >= 40 * 1024 && bytes - Files.size(files.get(files.size() - 1)) < 40 * 1024);
+        assertEquals(new String(Files.readAllBytes(files.get(3)), "UTF-8"), new CorpusGenerator(7).generate(3));
+        assertFalse(new CorpusGenerator(8).generate(3).equals(generator.generate(3)));
+
+        BatchParser batch = new BatchParser(2);
+        batch.setMacros(MacroTable.calculatorDefaults());
+        BatchParser.BatchResult result = batch.parse(files);
+        assertEquals(0, result.getFailureCount());
+        assertEquals(0, result.getSyntaxErrorCount());
+        ApiModel model = result.getModel();
+        assertTrue(model.getRefClasses().size() > 5);
+        assertFalse(model.getRefClasses().get(0).getProperties().isEmpty());
+        assertFalse(model.getEnums().isEmpty());
+    }
+
+    @Test
+    public void parsesSizes() {
+        assertEquals(512, CorpusGenerator.parseSize("512"));
+        assertEquals(3L << 20, CorpusGenerator.parseSize("3m"));
+        assertEquals(2L << 30, CorpusGenerator.parseSize("2G"));
+    }
+}
@@ -0,0 +1,60 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import java.io.IOException;
+import java.util.Arrays;
+import java.util.Collections;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.tree.ParseTreeWalker;
+import org.junit.Test;
+
+public class CxListenerTest {
+
+    private static ApiModel extract(CharStream input) {
+        CPPCXParser parser = new CPPCXParser(new CommonTokenStream(new CPPCXLexer(input)));
+        CxListener listener = new CxListener();
+        ParseTreeWalker.DEFAULT.walk(listener, new TwoStageParser().parse(parser));
+        return listener.getModel();
+    }
+
+    @Test
+    public void extractsRefClassFromMinimalExample() throws IOException {
+        ApiModel model = extract(CharStreams.fromStream(getClass().getResourceAsStream("/min.cpp")));
+
+        assertEquals(1, model.getClasses().size());
+        ApiModel.ClassInfo cls = model.getClasses().get(0);
+        assertEquals("CalculatorApp::NavCategory", cls.getQualifiedName());
+        assertEquals("ref class", cls.getKey());
+        assertTrue(cls.isRef());
+        assertTrue(cls.isSealed());
+        assertEquals("public", cls.getAccess());
+        assertEquals(Collections.singletonList("Windows::UI::Xaml::Data::Bindable"), cls.getAttributes());
+        assertEquals(Collections.singletonList("Windows::UI::Xaml::Data::INotifyPropertyChanged"), cls.getBases());
+        assertEquals(1, cls.getProperties().size());
+        assertEquals("AutomationId", cls.getProperties().get(0).getName());
+        assertEquals("Platform::String^", cls.getProperties().get(0).getType());
+    }
+
+    @Test
+    public void extractsEnums() {
+        ApiModel model = extract(CharStreams.fromString(
+                "namespace N { public enum class Mode : int { A = 1, B }; struct S { enum Kind { X }; }; }"));
+
+        assertEquals(2, model.getEnums().size());
+        ApiModel.EnumInfo mode = model.getEnums().get(0);
+        assertEquals("N::Mode", mode.getQualifiedName());
+        assertTrue(mode.isScoped());
+        assertEquals("public", mode.getAccess());
+        assertEquals("int", mode.getUnderlyingType());
+        assertEquals(Arrays.asList("A", "B"), mode.getEnumerators());
+        assertEquals("N::S::Kind", model.getEnums().get(1).getQualifiedName());
+    }
+}
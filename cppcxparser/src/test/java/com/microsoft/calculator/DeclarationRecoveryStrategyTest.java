@@ -0,0 +1,66 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.util.List;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.tree.ParseTreeWalker;
+import org.junit.Test;
+
+public class DeclarationRecoveryStrategyTest {
+
+    private final DiagnosticCollector diagnostics = new DiagnosticCollector();
+    private DeclarationRecoveryStrategy strategy;
+
+    @Test
+    public void skipsBrokenDeclarationAndStrayBrace() {
+        ApiModel model = parse("int a = 1 + ;\n}\nref class B {};\nref class C { int x = ; int y; };", 100);
+
+        assertEquals(2, model.getClasses().size());
+        assertEquals("B", model.getClasses().get(0).getName());
+        assertEquals("C", model.getClasses().get(1).getName());
+        List<DiagnosticCollector.Diagnostic> errors = diagnostics.getDiagnostics();
+        // The stray brace comes before anything parsed again and is not reported.
+        assertEquals(2, errors.size());
+        assertEquals(1, errors.get(0).getLine());
+        assertEquals(4, errors.get(1).getLine());
+        assertEquals(DiagnosticCollector.Diagnostic.Kind.PARSER, errors.get(0).getKind());
+        assertEquals(";", errors.get(0).getToken());
+        assertFalse(strategy.isTruncated());
+    }
+
+    @Test
+    public void skipsRestOfFileAfterTooManyErrors() {
+        StringBuilder text = new StringBuilder();
+        for (int i = 0; i < 10; i++)
+            text.append("int a").append(i).append(" = 1 + ;\n");
+        text.append("ref class Z {};");
+        ApiModel model = parse(text.toString(), 3);
+
+        assertEquals(3, diagnostics.getDiagnostics().size());
+        assertTrue(strategy.isTruncated());
+        assertTrue(model.getClasses().isEmpty());
+    }
+
+    private ApiModel parse(String text, int maxErrors) {
+        CPPCXLexer lexer = new CPPCXLexer(CharStreams.fromString(text));
+        lexer.removeErrorListeners();
+        lexer.addErrorListener(diagnostics);
+        CPPCXParser parser = new CPPCXParser(new CommonTokenStream(lexer));
+        parser.removeErrorListeners();
+        parser.addErrorListener(diagnostics);
+        strategy = new DeclarationRecoveryStrategy(maxErrors);
+        parser.setErrorHandler(strategy);
+
+        CxListener listener = new CxListener();
+        ParseTreeWalker.DEFAULT.walk(listener, new TwoStageParser().parse(parser));
+        return listener.getModel();
+    }
+}
@@ -0,0 +1,70 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.junit.Test;
+
+public class DfaCacheTest {
+
+    private static CPPCXParser exampleParser() throws IOException {
+        try (InputStream is = DfaCacheTest.class.getResourceAsStream("/example.cpp")) {
+            CPPCXParser parser = new CPPCXParser(new CommonTokenStream(new CPPCXLexer(CharStreams.fromStream(is))));
+            parser.removeErrorListeners();
+            return parser;
+        }
+    }
+
+    @Test
+    public void savedCacheReloadsIntoWarmDfa() throws IOException {
+        DfaCache.warmUp();
+        int states = DfaCache.stateCount();
+        assertTrue(states > 0);
+
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        DfaCache.save(out);
+
+        // Every saved state is already there, conflict states included.
+        int added = DfaCache.load(new ByteArrayInputStream(out.toByteArray()));
+        assertEquals(0, added);
+        assertEquals(states, DfaCache.stateCount());
+    }
+
+    @Test
+    public void savedCacheRestoresColdDfa() throws IOException {
+        DfaCache.warmUp();
+        CPPCXParser parser = exampleParser();
+        TwoStageParser warm = new TwoStageParser();
+        String tree = warm.parse(parser).toStringTree(parser);
+        int states = DfaCache.stateCount();
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        DfaCache.save(out);
+
+        parser.getInterpreter().clearDFA();
+        assertEquals(0, DfaCache.stateCount());
+        assertEquals(states, DfaCache.load(new ByteArrayInputStream(out.toByteArray())));
+        assertEquals(states, DfaCache.stateCount());
+
+        // The restored DFA predicts the whole file: same tree, same stages, no new states.
+        parser = exampleParser();
+        TwoStageParser cold = new TwoStageParser();
+        assertEquals(tree, cold.parse(parser).toStringTree(parser));
+        assertEquals(warm.getFallbackCount(), cold.getFallbackCount());
+        assertEquals(states, DfaCache.stateCount());
+    }
+
+    @Test(expected = IOException.class)
+    public void rejectsForeignData() throws IOException {
+        DfaCache.load(new ByteArrayInputStream(new byte[16]));
+    }
+}
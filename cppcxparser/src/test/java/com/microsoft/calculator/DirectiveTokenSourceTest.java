@@ -0,0 +1,37 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import java.util.Collections;
+
+import com.microsoft.CPPCXLexer;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.Token;
+import org.junit.Test;
+
+public class DirectiveTokenSourceTest {
+
+    @Test
+    public void indexesAndDropsDirectives() {
+        DirectiveTokenSource source = new DirectiveTokenSource(new CPPCXLexer(CharStreams.fromString(
+                "#pragma once\n#include \"pch.h\"\n# include <vector>\n#ifdef X\n#define MAX(a, b) \\\n  a\n#endif\n"
+                        + "int x;\n")));
+        CommonTokenStream tokens = new CommonTokenStream(source);
+        tokens.fill();
+
+        for (Token token : tokens.getTokens())
+            assertTrue(token.getType() != CPPCXLexer.Directive && token.getType() != CPPCXLexer.MultiLineMacro);
+        assertEquals(4, tokens.size());
+        DirectiveIndex index = source.getIndex();
+        assertEquals(4, index.size());
+        assertTrue(index.hasPragmaOnce());
+        assertEquals(Collections.singletonList("pch.h"), index.getNames(DirectiveIndex.Kind.INCLUDE));
+        assertEquals(Collections.singletonList("vector"), index.getNames(DirectiveIndex.Kind.SYSTEM_INCLUDE));
+        assertEquals(DirectiveIndex.Kind.DEFINE, index.getKind(3));
+        assertEquals("MAX", index.getName(3));
+        assertEquals(5, index.getLine(3));
+    }
+}
@@ -0,0 +1,46 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+import com.microsoft.CPPCXParser.BinaryExpressionContext;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.tree.ParseTree;
+import org.antlr.v4.runtime.tree.ParseTreeWalker;
+import org.junit.Test;
+
+public class ExpressionCompatListenerTest {
+
+    @Test
+    public void reportsEachChainOnceWithItsOperands() {
+        CPPCXParser parser = new CPPCXParser(
+                new CommonTokenStream(new CPPCXLexer(CharStreams.fromString("a + b - c * d < e"))));
+        final List<String> chains = new ArrayList<>();
+        ExpressionCompatListener listener = new ExpressionCompatListener() {
+            @Override
+            public void enterOperatorChain(Level level, BinaryExpressionContext chain,
+                    List<BinaryExpressionContext> operands, List<ParseTree> operators) {
+                StringBuilder sb = new StringBuilder(level.name());
+                for (int i = 0; i < operands.size(); i++) {
+                    if (i > 0)
+                        sb.append(' ').append(operators.get(i - 1).getText());
+                    sb.append(' ').append(operands.get(i).getText());
+                }
+                chains.add(sb.toString());
+            }
+        };
+
+        ParseTreeWalker.DEFAULT.walk(listener, parser.expression());
+
+        assertEquals(0, parser.getNumberOfSyntaxErrors());
+        assertEquals(Arrays.asList("RELATIONAL a+b-c*d < e", "ADDITIVE a + b - c*d", "MULTIPLICATIVE c * d"),
+                chains);
+    }
+}
@@ -0,0 +1,88 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assume.assumeTrue;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.Map;
+import java.util.Properties;
+
+import org.antlr.v4.runtime.atn.DecisionInfo;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+public class GrammarProfilerTest {
+
+    @Rule
+    public TemporaryFolder folder = new TemporaryFolder();
+
+    private GrammarProfiler.Report profile(String... resources) throws IOException {
+        List<Path> files = new ArrayList<>();
+        for (String resource : resources) {
+            Path file = folder.getRoot().toPath().resolve(resource);
+            try (InputStream is = getClass().getResourceAsStream("/" + resource)) {
+                Files.copy(is, file);
+            }
+            files.add(file);
+        }
+        GrammarProfiler profiler = new GrammarProfiler();
+        profiler.setMacros(MacroTable.calculatorDefaults());
+        return profiler.profile(files);
+    }
+
+    @Test
+    public void reportsRulesAndComparesWithBaseline() throws IOException {
+        GrammarProfiler.Report report = profile("example.cpp");
+        assertFalse(report.getRules().isEmpty());
+        assertTrue(report.getTotal().getInvocations() > 0);
+
+        Path baseline = folder.getRoot().toPath().resolve("baseline.properties");
+        report.writeBaseline(baseline);
+        assertTrue(report.compare(GrammarProfiler.Report.readBaseline(baseline), 1).isEmpty());
+
+        Properties lower = new Properties();
+        for (Map.Entry<String, Long> count : report.getCounts().entrySet())
+            lower.setProperty(count.getKey(), String.valueOf(count.getValue() / 3));
+        assertEquals(report.getCounts().size(), report.compare(lower, GrammarProfiler.DEFAULT_FACTOR).size());
+    }
+
+    @Test
+    public void countThatDoublesIsARegression() {
+        ParseStats stats = new ParseStats();
+        DecisionInfo info = new DecisionInfo(0);
+        info.invocations = 10;
+        info.LL_Fallback = 4;
+        stats.addDecisions(new DecisionInfo[] { info });
+        GrammarProfiler.Report report = new GrammarProfiler.Report(stats);
+
+        Properties baseline = new Properties();
+        baseline.setProperty("total.llFallback", "2");
+        assertTrue(report.compare(baseline, GrammarProfiler.DEFAULT_FACTOR).contains("total.llFallback: 2 -> 4"));
+        baseline.setProperty("total.llFallback", "3");
+        assertFalse(report.compare(baseline, GrammarProfiler.DEFAULT_FACTOR).contains("total.llFallback: 3 -> 4"));
+        baseline.setProperty("total.llFallback", "4");
+        assertFalse(report.compare(baseline, 1).contains("total.llFallback: 4 -> 4"));
+    }
+
+    @Test
+    public void bundledCorpusMatchesStoredBaseline() throws IOException {
+        Properties baseline = new Properties();
+        try (InputStream is = getClass().getResourceAsStream("/grammar-baseline.properties")) {
+            baseline.load(is);
+        }
+        // The stored baseline has no counts until it is written with GrammarProfiler --update.
+        assumeTrue(baseline.containsKey("files"));
+
+        GrammarProfiler.Report report = profile("example.cpp", "min.cpp");
+        assertEquals(Collections.<String>emptyList(), report.compare(baseline, GrammarProfiler.DEFAULT_FACTOR));
+    }
+}
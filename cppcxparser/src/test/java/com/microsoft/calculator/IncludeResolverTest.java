@@ -0,0 +1,71 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertSame;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Arrays;
+import java.util.Collections;
+
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+public class IncludeResolverTest {
+
+    @Rule
+    public TemporaryFolder folder = new TemporaryFolder();
+
+    private Path a;
+    private Path b;
+    private Path shared;
+    private Path common;
+
+    @Before
+    public void setUp() throws IOException {
+        Path src = folder.newFolder("src").toPath();
+        Path inc = folder.newFolder("inc").toPath();
+        a = write(src.resolve("a.cpp"), "#include \"Shared.h\"\n#include <string>\nref class A {};");
+        b = write(src.resolve("b.cpp"), "#include \"./Shared.h\"\nref class B {};");
+        shared = write(src.resolve("Shared.h"), "#pragma once\n#include <Common.h>\nref class Shared {};");
+        common = write(inc.resolve("Common.h"), "#include \"../src/Shared.h\"\nenum class Common { X };");
+    }
+
+    @Test
+    public void followsIncludesOnceAndRecordsUnresolved() throws IOException {
+        IncludeResolver resolver = new IncludeResolver(Collections.singletonList(common.getParent()));
+        IncludeResolver.IncludeGraph graph = resolver.resolve(Arrays.asList(a, b));
+
+        assertEquals(Arrays.asList(a.toRealPath(), b.toRealPath(), shared.toRealPath(), common.toRealPath()),
+                graph.getFiles());
+        assertEquals(Arrays.asList(shared.toRealPath(), common.toRealPath()), graph.getHeaders());
+        assertEquals(Collections.singletonList("string"), graph.getUnresolved(a.toRealPath()));
+        assertEquals(1, graph.getUnresolvedCount());
+        // Shared.h and Common.h include each other.
+        assertEquals(Collections.singleton(common.toRealPath()), graph.transitiveIncludes(shared.toRealPath()));
+    }
+
+    @Test
+    public void headersAreParsedOnceAndShared() throws IOException, InterruptedException {
+        IncludeResolver resolver = new IncludeResolver(Collections.singletonList(common.getParent()));
+        ProjectParser.ProjectResult result = new ProjectParser(new BatchParser(2), resolver)
+                .parse(Arrays.asList(a, b));
+
+        assertEquals(4, result.getBatchResult().getFiles().size());
+        assertEquals(resolver.resolve(Arrays.asList(a, b)).getFiles(), result.getGraph().getFiles());
+        assertEquals(Collections.singletonList("string"), result.getGraph().getUnresolved(a.toRealPath()));
+        ApiModel modelA = result.getModel(a);
+        ApiModel modelB = result.getModel(b);
+        assertEquals("A", modelA.getClasses().get(0).getName());
+        assertEquals("Shared", modelA.getClasses().get(1).getName());
+        assertEquals("Common", modelA.getEnums().get(0).getName());
+        assertSame(modelA.getClasses().get(1), modelB.getClasses().get(1));
+    }
+
+    private static Path write(Path file, String text) throws IOException {
+        return Files.write(file, text.getBytes("UTF-8"));
+    }
+}
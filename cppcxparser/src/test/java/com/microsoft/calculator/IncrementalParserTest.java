@@ -0,0 +1,62 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import java.util.List;
+
+import com.microsoft.CPPCXParser.MemberdeclarationContext;
+
+import org.antlr.v4.runtime.ParserRuleContext;
+import org.antlr.v4.runtime.Token;
+import org.junit.Test;
+
+public class IncrementalParserTest {
+
+    private static final String SOURCE = "namespace N {\nref class A {\npublic:\n    int a;\n    int b;\n};\n}\nint c;\n";
+
+    @Test
+    public void reparsesOnlyTheEditedMember() {
+        IncrementalParser incremental = new IncrementalParser(SOURCE, "test.cpp");
+        int a = SOURCE.indexOf("int a;") + 4;
+
+        ParserRuleContext reparsed = incremental.edit(a, a + 1, "alpha,\n  beta");
+
+        assertTrue(reparsed instanceof MemberdeclarationContext);
+        assertEquals("intalpha,beta;", reparsed.getText());
+        assertEquals(1, incremental.getFullParseCount());
+        assertEquals(1, incremental.getIncrementalParseCount());
+
+        IncrementalParser fresh = new IncrementalParser(incremental.getText(), "test.cpp");
+        assertEquals(fresh.getTree().toStringTree(), incremental.getTree().toStringTree());
+        assertSameTokens(fresh.getTokens(), incremental.getTokens());
+    }
+
+    @Test
+    public void fallsBackToFullParseWhenTheEditEscapesTheMember() {
+        IncrementalParser incremental = new IncrementalParser(SOURCE, "test.cpp");
+        int semi = SOURCE.indexOf("int b;") + 5;
+
+        ParserRuleContext reparsed = incremental.edit(semi, semi + 1, "; int d;");
+
+        assertEquals(incremental.getTree(), reparsed);
+        assertEquals(2, incremental.getFullParseCount());
+        assertEquals(0, incremental.getSyntaxErrorCount());
+    }
+
+    private static void assertSameTokens(List<Token> expected, List<Token> actual) {
+        assertEquals(expected.size(), actual.size());
+        for (int i = 0; i < expected.size(); i++) {
+            Token e = expected.get(i);
+            Token t = actual.get(i);
+            String where = "token " + i;
+            assertEquals(where, e.getType(), t.getType());
+            assertEquals(where, e.getText(), t.getText());
+            assertEquals(where, e.getTokenIndex(), t.getTokenIndex());
+            assertEquals(where, e.getStartIndex(), t.getStartIndex());
+            assertEquals(where, e.getStopIndex(), t.getStopIndex());
+            assertEquals(where, e.getLine(), t.getLine());
+            assertEquals(where, e.getCharPositionInLine(), t.getCharPositionInLine());
+        }
+    }
+}
@@ -0,0 +1,48 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.util.ArrayList;
+import java.util.List;
+
+import com.microsoft.CPPCXLexer;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.Lexer;
+import org.antlr.v4.runtime.Token;
+import org.junit.Test;
+
+public class KeywordLexerTest {
+
+    @Test
+    public void lexesLikeCppcxLexer() throws IOException {
+        String text;
+        try (InputStream is = getClass().getResourceAsStream("/example.cpp")) {
+            text = CharStreams.fromStream(is).toString();
+        }
+        text += "\nbool b = true || false; auto p = nullptr; int refs, classy, _ref, ref_; reinterpret_cast<int>(x);";
+
+        assertEquals(tokens(new CPPCXLexer(CharStreams.fromString(text))),
+                tokens(new KeywordLexer(CharStreams.fromString(text))));
+    }
+
+    @Test
+    public void looksUpKeywords() {
+        assertEquals(CPPCXLexer.Ref, KeywordTable.type("ref"));
+        assertEquals(CPPCXLexer.Sealed, KeywordTable.type("sealed"));
+        assertEquals(CPPCXLexer.BooleanLiteral, KeywordTable.type("false"));
+        assertEquals(CPPCXLexer.PointerLiteral, KeywordTable.type("nullptr"));
+        assertEquals(CPPCXLexer.Identifier, KeywordTable.type("Ref"));
+        assertEquals(CPPCXLexer.Identifier, KeywordTable.type("reinterpret_casts"));
+    }
+
+    private static List<String> tokens(Lexer lexer) {
+        List<String> tokens = new ArrayList<>();
+        for (Token token = lexer.nextToken(); token.getType() != Token.EOF; token = lexer.nextToken())
+            tokens.add(token.getType() + ":" + token.getText() + "@" + token.getLine() + ":"
+                    + token.getCharPositionInLine() + ":" + token.getChannel());
+        return tokens;
+    }
+}
@@ -0,0 +1,56 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.util.List;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.tree.ParseTreeWalker;
+import org.junit.Test;
+
+public class MacroExpandingTokenSourceTest {
+
+    @Test
+    public void propertyMacrosBecomePropertyDefinitions() throws IOException {
+        MacroTable macros = MacroTable.calculatorDefaults();
+        CPPCXParser parser;
+        try (InputStream is = getClass().getResourceAsStream("/min.cpp")) {
+            parser = new CPPCXParser(new CommonTokenStream(
+                    new MacroExpandingTokenSource(new CPPCXLexer(CharStreams.fromStream(is)), macros)));
+        }
+        CxListener listener = new CxListener();
+        ParseTreeWalker.DEFAULT.walk(listener, parser.translationUnit());
+
+        assertEquals(0, parser.getNumberOfSyntaxErrors());
+        List<ApiModel.PropertyInfo> properties = listener.getModel().getClasses().get(0).getProperties();
+        assertEquals("property Platform::String^ Name", properties.get(0).toString());
+        assertEquals(6, properties.get(0).getLine());
+        assertEquals("AutomationId", properties.get(1).getName());
+    }
+
+    @Test
+    public void pastesAndStopsAtRecursion() {
+        MacroTable macros = new MacroTable();
+        macros.define("#define CAT(a, b) a ## b");
+        macros.define("SELF SELF + 1");
+        macros.define("STR(x) #x");
+        CommonTokenStream tokens = new CommonTokenStream(new MacroExpandingTokenSource(
+                new CPPCXLexer(CharStreams.fromString("int CAT(x, y) = SELF; auto s = STR(a b); CAT;")), macros));
+        tokens.fill();
+
+        StringBuilder text = new StringBuilder();
+        for (Token token : tokens.getTokens()) {
+            if (token.getType() != Token.EOF)
+                text.append(token.getText()).append(' ');
+        }
+        assertEquals("int xy = SELF + 1 ; auto s = \"a b\" ; CAT ; ", text.toString());
+        assertEquals(CPPCXLexer.Identifier, tokens.get(1).getType());
+    }
+}
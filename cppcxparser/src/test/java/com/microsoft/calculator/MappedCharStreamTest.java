@@ -0,0 +1,80 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+
+import com.microsoft.CPPCXLexer;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.IntStream;
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.misc.Interval;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+public class MappedCharStreamTest {
+
+    @Rule
+    public TemporaryFolder folder = new TemporaryFolder();
+
+    @Test
+    public void lexesLikeCodePointStream() throws IOException {
+        StringBuilder text = new StringBuilder();
+        for (int i = 0; i < 20; i++)
+            text.append("ref class C").append(i).append(" { property String^ Name; }; // Gr\u00fc\u00dfe \ud83d\ude00")
+                    .append('\n');
+        Path file = folder.getRoot().toPath().resolve("a.cpp");
+        Files.write(file, text.toString().getBytes(StandardCharsets.UTF_8));
+
+        MappedCharStream mapped = MappedCharStream.fromPath(file);
+        assertFalse(mapped.isAscii());
+        assertEquals(tokens(CharStreams.fromString(text.toString())), tokens(mapped));
+    }
+
+    @Test
+    public void seeksAndSkipsByteOrderMark() {
+        byte[] bom = { (byte) 0xef, (byte) 0xbb, (byte) 0xbf };
+        byte[] body = "a\u00e9b".getBytes(StandardCharsets.UTF_8);
+        ByteBuffer buffer = ByteBuffer.allocate(bom.length + body.length).put(bom).put(body);
+        buffer.flip();
+        MappedCharStream input = new MappedCharStream(buffer, "x.cpp");
+
+        assertEquals(3, input.size());
+        input.seek(2);
+        assertEquals('b', input.LA(1));
+        assertEquals(0xe9, input.LA(-1));
+        input.consume();
+        assertEquals(IntStream.EOF, input.LA(1));
+        assertEquals("\u00e9b", input.getText(Interval.of(1, 2)));
+        input.seek(0);
+        assertEquals('a', input.LA(1));
+    }
+
+    @Test
+    public void asciiIsIndexedByByte() {
+        MappedCharStream input = new MappedCharStream(ByteBuffer.wrap("int x;".getBytes(StandardCharsets.UTF_8)),
+                null);
+        assertTrue(input.isAscii());
+        assertEquals(IntStream.UNKNOWN_SOURCE_NAME, input.getSourceName());
+        assertEquals("x", input.getText(Interval.of(4, 4)));
+    }
+
+    private static List<String> tokens(CharStream input) {
+        CPPCXLexer lexer = new CPPCXLexer(input);
+        List<String> tokens = new ArrayList<>();
+        for (Token token = lexer.nextToken(); token.getType() != Token.EOF; token = lexer.nextToken())
+            tokens.add(token.getType() + ":" + token.getText() + "@" + token.getStartIndex());
+        return tokens;
+    }
+}
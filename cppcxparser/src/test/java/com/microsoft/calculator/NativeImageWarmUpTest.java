@@ -0,0 +1,14 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertTrue;
+
+import org.junit.Test;
+
+public class NativeImageWarmUpTest {
+
+    @Test
+    public void populatesDfaOnInitialization() {
+        assertTrue(NativeImageWarmUp.DFA_STATES > 0);
+        assertTrue(DfaCache.stateCount() >= NativeImageWarmUp.DFA_STATES);
+    }
+}
@@ -0,0 +1,54 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Collections;
+import java.util.List;
+
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+public class ParseCacheTest {
+
+    @Rule
+    public TemporaryFolder folder = new TemporaryFolder();
+
+    @Test
+    public void secondRunLoadsUnchangedFilesFromCache() throws IOException, InterruptedException {
+        Path sources = folder.newFolder("src").toPath();
+        Files.write(sources.resolve("a.cpp"), "ref class A {};".getBytes("UTF-8"));
+        Files.write(sources.resolve("b.cpp"), "ref class B {};".getBytes("UTF-8"));
+        List<Path> files = BatchParser.collectSources(Collections.singletonList(sources));
+        Path cacheDir = folder.getRoot().toPath().resolve("cache");
+
+        BatchParser first = new BatchParser(1);
+        first.setCache(new ParseCache(cacheDir));
+        first.parse(files);
+        assertEquals(2, first.getCache().getMissCount());
+
+        Files.write(sources.resolve("b.cpp"), "ref class C {};".getBytes("UTF-8"));
+        BatchParser second = new BatchParser(1);
+        second.setCache(new ParseCache(cacheDir));
+        BatchParser.BatchResult result = second.parse(files);
+
+        assertEquals(1, second.getCache().getHitCount());
+        assertEquals(1, second.getCache().getMissCount());
+        assertEquals("A", result.getFiles().get(0).getModel().getClasses().get(0).getName());
+        assertEquals("C", result.getFiles().get(1).getModel().getClasses().get(0).getName());
+    }
+
+    @Test
+    public void damagedEntryIsAMiss() throws IOException {
+        ParseCache cache = new ParseCache(folder.getRoot().toPath());
+        byte[] content = "int a;".getBytes("UTF-8");
+        Files.write(cache.getDirectory().resolve(ParseCache.key("", content) + ".model"), new byte[] { 1, 2, 3 });
+
+        assertNull(cache.get(content));
+        assertEquals(1, cache.getMissCount());
+    }
+}
@@ -0,0 +1,42 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.io.IOException;
+import java.io.StringWriter;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Collections;
+
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+public class ParseStatsTest {
+
+    @Rule
+    public TemporaryFolder folder = new TemporaryFolder();
+
+    @Test
+    public void measuresFilesAndDecisions() throws IOException, InterruptedException {
+        Path file = folder.getRoot().toPath().resolve("a.cpp");
+        Files.write(file, "ref class A { int f() { return 1 + 2; } };".getBytes("UTF-8"));
+        BatchParser batch = new BatchParser(1);
+        batch.setStats(new ParseStats());
+
+        batch.parse(Collections.singletonList(file));
+
+        ParseStats.FileStats stats = batch.getStats().getFiles().get(0);
+        assertEquals(file, stats.getFile());
+        assertTrue(stats.getTokens() > 10);
+        assertTrue(stats.getNodes() > stats.getTokens());
+        assertFalse(batch.getStats().getDecisions().isEmpty());
+
+        StringWriter json = new StringWriter();
+        batch.getStats().writeJson(json);
+        assertTrue(json.toString().startsWith("{\n  \"wallMs\": "));
+        assertTrue(json.toString().contains("\"decisions\": [\n    {\n      \"decision\": "));
+    }
+}
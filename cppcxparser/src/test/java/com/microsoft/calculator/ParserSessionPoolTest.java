@@ -0,0 +1,42 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+
+import org.junit.Test;
+
+public class ParserSessionPoolTest {
+
+    @Test
+    public void sessionParsesRequestsInTurn() {
+        ParserSession session = new ParserSession();
+
+        ParserSession.Response broken = session.parse(new ParserSession.Request("a.cpp", "int a = ;"));
+        ParserSession.Response clean = session.parse(new ParserSession.Request("b.cpp",
+                "namespace N { ref class B { void f() { } }; }", true));
+
+        assertTrue(broken.getSyntaxErrors() > 0);
+        assertEquals("a.cpp", broken.getDiagnostics().get(0).getSource());
+        assertEquals(0, clean.getSyntaxErrors());
+        assertTrue(clean.getDiagnostics().isEmpty());
+        assertEquals("N::B", clean.getModel().getClasses().get(0).getQualifiedName());
+        assertTrue(broken.getModel().isEmpty());
+    }
+
+    @Test
+    public void poolReusesReleasedSessions() {
+        ParserSessionPool pool = new ParserSessionPool(1, null);
+        ParserSession first = pool.acquire();
+        ParserSession second = pool.acquire();
+        pool.release(first);
+        pool.release(second);
+
+        assertSame(first, pool.acquire());
+        pool.release(first);
+        assertEquals("C", pool.parse(new ParserSession.Request("c.cpp", "ref class C {};")).getModel().getClasses()
+                .get(0).getName());
+        assertEquals(2, pool.getCreatedCount());
+        assertEquals(2, pool.getReusedCount());
+    }
+}
@@ -0,0 +1,64 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Collections;
+import java.util.concurrent.TimeUnit;
+
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+public class ProjectIndexerTest {
+
+    @Rule
+    public TemporaryFolder folder = new TemporaryFolder();
+
+    @Test
+    public void reindexesChangedFiles() throws IOException, InterruptedException {
+        Path sources = folder.newFolder("src").toPath().toAbsolutePath().normalize();
+        Path a = sources.resolve("a.h");
+        Files.write(a, "ref class A {};".getBytes("UTF-8"));
+        Files.write(sources.resolve("readme.txt"), "ref class Ignored {};".getBytes("UTF-8"));
+
+        try (ProjectIndexer indexer = new ProjectIndexer(new BatchParser(1), Collections.singletonList(sources))) {
+            indexer.setQuietPeriod(50);
+            indexer.start();
+            ApiIndex index = indexer.getIndex();
+            assertEquals(1, index.getClasses("A").size());
+
+            Files.write(a, "ref class A : IB {}; ref class B : IB {};".getBytes("UTF-8"));
+            Path sub = Files.createDirectories(sources.resolve("sub"));
+            Files.write(sub.resolve("c.cpp"), "ref class C : IB {};".getBytes("UTF-8"));
+            awaitUpdates(indexer, 3);
+            assertEquals(3, index.getClassesWithBase("IB").size());
+            assertEquals(sub.resolve("c.cpp"), index.getFile(index.getClasses("C").get(0)));
+
+            Files.delete(a);
+            awaitUpdates(indexer, 1);
+            assertTrue(index.getClasses("A").isEmpty());
+            assertEquals(1, index.getFiles().size());
+        }
+    }
+
+    /**
+     * Applies updates until the index holds the number of classes, as the
+     * events of a change may arrive in several batches.
+     */
+    private static void awaitUpdates(ProjectIndexer indexer, int classes) throws IOException, InterruptedException {
+        long deadline = System.nanoTime() + TimeUnit.SECONDS.toNanos(30);
+        while (countClasses(indexer.getIndex()) != classes && System.nanoTime() < deadline)
+            indexer.update(1, TimeUnit.SECONDS);
+    }
+
+    private static int countClasses(ApiIndex index) {
+        int count = 0;
+        for (Path file : index.getFiles())
+            count += index.getModel(file).getClasses().size();
+        return count;
+    }
+}
@@ -0,0 +1,49 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.tree.ParseTreeWalker;
+import org.junit.Test;
+
+public class SkipBodyTokenSourceTest {
+
+    @Test
+    public void skipsFunctionBodiesButKeepsClassBodies() {
+        String source = "ref class A sealed {\n"
+                + "    property int X { int get() { return m_x + f(1, { 2 }); } }\n"
+                + "    void f() const { for (;;) { } }\n"
+                + "    int m_x;\n"
+                + "};\n";
+        SkipBodyTokenSource tokenSource = new SkipBodyTokenSource(new CPPCXLexer(CharStreams.fromString(source)));
+        CPPCXParser parser = new CPPCXParser(new CommonTokenStream(tokenSource));
+        CxListener listener = new CxListener();
+        ParseTreeWalker.DEFAULT.walk(listener, parser.translationUnit());
+
+        assertEquals(0, parser.getNumberOfSyntaxErrors());
+        assertEquals(2, tokenSource.getSkippedBodies().size());
+        assertEquals(2, tokenSource.getSkippedBodies().get(0).getStartLine());
+        assertEquals(3, tokenSource.getSkippedBodies().get(1).getStopLine());
+
+        ApiModel.ClassInfo cls = listener.getModel().getClasses().get(0);
+        assertEquals("ref class A sealed", cls.toString());
+        assertEquals("X", cls.getProperties().get(0).getName());
+    }
+
+    @Test
+    public void keepsBraceInitializersAfterBrackets() {
+        String source = "int a[] { 1, 2 };\n"
+                + "auto f = [] { return 1; };\n";
+        SkipBodyTokenSource tokenSource = new SkipBodyTokenSource(new CPPCXLexer(CharStreams.fromString(source)));
+        CPPCXParser parser = new CPPCXParser(new CommonTokenStream(tokenSource));
+        parser.translationUnit();
+
+        assertEquals(0, parser.getNumberOfSyntaxErrors());
+        assertEquals(1, tokenSource.getSkippedBodies().size());
+        assertEquals(2, tokenSource.getSkippedBodies().get(0).getStartLine());
+    }
+}
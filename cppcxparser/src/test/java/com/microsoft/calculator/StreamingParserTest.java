@@ -0,0 +1,44 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+
+import java.io.StringReader;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+import com.microsoft.CPPCXParser.DeclarationContext;
+
+import org.junit.Test;
+
+public class StreamingParserTest {
+
+    @Test
+    public void streamsNamespaceMembersOneAtATime() {
+        final List<String> events = new ArrayList<>();
+        StreamingParser.Handler handler = new StreamingParser.Handler() {
+            @Override
+            public void enterNamespace(String name) {
+                events.add("enter " + name);
+            }
+
+            @Override
+            public void declaration(DeclarationContext declaration) {
+                events.add(declaration.getText());
+            }
+
+            @Override
+            public void exitNamespace(String name) {
+                events.add("exit " + name);
+            }
+        };
+
+        String source = "int a;\nnamespace A::B { int b; namespace { int c; } }\nnamespace X = A;\n";
+        int errors = new StreamingParser().parse(new StringReader(source), "test.cpp", handler);
+
+        assertEquals(0, errors);
+        // getText() joins tokens without whitespace.
+        assertEquals(Arrays.asList("inta;", "enter A::B", "intb;", "enter ", "intc;", "exit ", "exit A::B",
+                "namespaceX=A;"), events);
+    }
+}
@@ -0,0 +1,37 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.junit.Test;
+
+public class SymbolScannerTest {
+
+    @Test
+    public void findsSymbolsWithTheirScopes() {
+        String source = "namespace App::Data {\n"
+                + "ref class Forward;\n"
+                + "public delegate void ChangedHandler(Platform::Object^ sender);\n"
+                + "public enum class Mode : int { A, B };\n"
+                + "template <class T> void f(T t) { }\n"
+                + "[Bindable] public ref class Item sealed : Base {\n"
+                + "public:\n"
+                + "    property Platform::String ^ Name { Platform::String ^ get(); }\n"
+                + "    property int Count;\n"
+                + "    virtual event Windows::Foundation::EventHandler<int> ^ Changed;\n"
+                + "};\n"
+                + "}\n";
+
+        List<String> symbols = new ArrayList<>();
+        for (SymbolScanner.Symbol symbol : new SymbolScanner().scan(CharStreams.fromString(source)))
+            symbols.add(symbol.toString());
+
+        assertEquals(Arrays.asList("3: delegate App::Data::ChangedHandler", "4: enum class App::Data::Mode",
+                "6: ref class App::Data::Item", "8: property App::Data::Item::Name",
+                "9: property App::Data::Item::Count", "10: event App::Data::Item::Changed"), symbols);
+    }
+}
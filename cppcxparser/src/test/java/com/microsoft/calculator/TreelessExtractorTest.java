@@ -0,0 +1,95 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.List;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+import com.microsoft.CPPCXParser.TranslationUnitContext;
+
+import org.antlr.v4.runtime.CharStream;
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.ParserRuleContext;
+import org.antlr.v4.runtime.tree.ParseTree;
+import org.junit.Test;
+
+public class TreelessExtractorTest {
+
+    private static CPPCXParser parser(CharStream input) {
+        return new CPPCXParser(new CommonTokenStream(new CPPCXLexer(input)));
+    }
+
+    private static CharStream example() throws IOException {
+        return CharStreams.fromStream(TreelessExtractorTest.class.getResourceAsStream("/example.cpp"));
+    }
+
+    @Test
+    public void extractsSameModelAsTree() throws IOException {
+        ApiModel built = ApiModelBuilder.build(new TwoStageParser().parse(parser(example())));
+
+        CPPCXParser parser = parser(example());
+        TreelessExtractor extractor = new TreelessExtractor(parser);
+        TranslationUnitContext tu = new TwoStageParser().parse(parser);
+
+        assertEquals(describe(built), describe(extractor.getModel()));
+        assertEquals(0, countRules(tu));
+    }
+
+    @Test
+    public void skipsTypesApiModelBuilderSkips() {
+        String text = "namespace N { [Bindable] public ref class A sealed : IA { public:"
+                + " property int X { int get() { struct InGetter {}; return 0; } } void f() { struct Local {}; } };"
+                + " enum class E { P = 1 << 2, Q }; }\nvoid g() { enum Hidden { Z }; }";
+        ApiModel built = ApiModelBuilder.build(new TwoStageParser().parse(parser(CharStreams.fromString(text))));
+
+        CPPCXParser parser = parser(CharStreams.fromString(text));
+        TreelessExtractor extractor = new TreelessExtractor(parser);
+        new TwoStageParser().parse(parser);
+
+        assertEquals(describe(built), describe(extractor.getModel()));
+        assertEquals(1, extractor.getModel().getClasses().size());
+        assertEquals(1, extractor.getModel().getEnums().size());
+    }
+
+    @Test
+    public void startsNewModelPerParse() {
+        CPPCXParser parser = parser(CharStreams.fromString("ref class A {};"));
+        TreelessExtractor extractor = new TreelessExtractor(parser);
+        parser.translationUnit();
+        parser.setInputStream(new CommonTokenStream(new CPPCXLexer(CharStreams.fromString("ref class B {};"))));
+        parser.translationUnit();
+
+        assertEquals(1, extractor.getModel().getClasses().size());
+        assertEquals("B", extractor.getModel().getClasses().get(0).getName());
+
+        extractor.detach();
+        parser.setInputStream(new CommonTokenStream(new CPPCXLexer(CharStreams.fromString("ref class C {};"))));
+        assertTrue(countRules(parser.translationUnit()) > 0);
+    }
+
+    private static int countRules(ParseTree tree) {
+        int count = 0;
+        for (int i = 0; i < tree.getChildCount(); i++) {
+            if (tree.getChild(i) instanceof ParserRuleContext)
+                count += 1 + countRules(tree.getChild(i));
+        }
+        return count;
+    }
+
+    private static List<String> describe(ApiModel model) {
+        List<String> lines = new ArrayList<>();
+        for (ApiModel.ClassInfo cls : model.getClasses()) {
+            lines.add(cls.toString());
+            for (ApiModel.PropertyInfo property : cls.getProperties())
+                lines.add("  " + property);
+        }
+        for (ApiModel.EnumInfo e : model.getEnums())
+            lines.add(e.toString());
+        return lines;
+    }
+}
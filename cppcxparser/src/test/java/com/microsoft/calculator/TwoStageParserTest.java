@@ -0,0 +1,77 @@
+package com.microsoft.calculator;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.IOException;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+import com.microsoft.CPPCXParser.TranslationUnitContext;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.NoViableAltException;
+import org.antlr.v4.runtime.RecognitionException;
+import org.antlr.v4.runtime.atn.PredictionMode;
+import org.junit.Test;
+
+public class TwoStageParserTest {
+
+    private static CPPCXParser parserFor(String resource) throws IOException {
+        CPPCXLexer lexer = new CPPCXLexer(CharStreams.fromStream(TwoStageParserTest.class.getResourceAsStream(resource)));
+        return new CPPCXParser(new CommonTokenStream(lexer));
+    }
+
+    @Test
+    public void parsesAndRestoresParserState() throws IOException {
+        CPPCXParser parser = parserFor("/min.cpp");
+        TwoStageParser twoStage = new TwoStageParser();
+
+        TranslationUnitContext tu = twoStage.parse(parser);
+
+        assertNotNull(tu.EOF());
+        assertEquals(0, parser.getNumberOfSyntaxErrors());
+        assertEquals(1, twoStage.getParseCount());
+        assertTrue(twoStage.getFallbackCount() <= 1);
+        assertEquals(PredictionMode.LL, parser.getInterpreter().getPredictionMode());
+        assertEquals(1, parser.getErrorListeners().size());
+    }
+
+    @Test
+    public void reportsErrorsOnlyOnceAfterFallback() throws IOException {
+        CPPCXLexer lexer = new CPPCXLexer(CharStreams.fromString("class A { int x; ) };"));
+        CPPCXParser parser = new CPPCXParser(new CommonTokenStream(lexer));
+        parser.removeErrorListeners();
+        TwoStageParser twoStage = new TwoStageParser();
+
+        twoStage.parse(parser);
+
+        assertEquals(1, twoStage.getFallbackCount());
+        assertEquals(1, parser.getNumberOfSyntaxErrors());
+    }
+
+    @Test
+    public void sllFailureIsNotASyntaxError() throws IOException {
+        CPPCXParser parser = parserFor("/min.cpp");
+        parser.removeErrorListeners();
+        TwoStageParser twoStage = new TwoStageParser();
+        // Fails the SLL stage the way a prediction error inside a rule does.
+        TwoStageParser.StartRule<TranslationUnitContext> rule = new TwoStageParser.StartRule<TranslationUnitContext>() {
+            @Override
+            public TranslationUnitContext invoke(CPPCXParser parser) {
+                if (parser.getInterpreter().getPredictionMode() == PredictionMode.SLL) {
+                    RecognitionException e = new NoViableAltException(parser);
+                    parser.getErrorHandler().reportError(parser, e);
+                    parser.getErrorHandler().recover(parser, e);
+                }
+                return parser.translationUnit();
+            }
+        };
+
+        assertNotNull(twoStage.parse(parser, rule).EOF());
+        assertEquals(1, twoStage.getFallbackCount());
+        assertEquals(0, parser.getNumberOfSyntaxErrors());
+    }
+}
@@ -0,0 +1,90 @@
+package com.microsoft.calculator.bench;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+import com.microsoft.calculator.CorpusGenerator;
+
+/**
+ * The sources a benchmark runs over: the bundled example.cpp, min.cpp, a
+ * scaled corpus of {@link #SCALED_FILES} files, each example.cpp in a
+ * namespace of its own, or a generated corpus of files from a
+ * {@link CorpusGenerator} of the {@code corpus.bytes} system property's
+ * size, 4m by default. The generated corpus is not in the default
+ * parameters; select it with {@code -p corpus=generated}.
+ */
+final class Corpus {
+
+    static final int SCALED_FILES = 50;
+    static final String GENERATED_BYTES = "4m";
+
+    private final List<String> sources;
+    private final long bytes;
+
+    private Corpus(List<String> sources) {
+        this.sources = Collections.unmodifiableList(sources);
+        long total = 0;
+        for (String source : sources)
+            total += source.getBytes(StandardCharsets.UTF_8).length;
+        this.bytes = total;
+    }
+
+    /**
+     * {@code example}, {@code min}, {@code scaled} or {@code generated}.
+     */
+    static Corpus load(String name) throws IOException {
+        switch (name) {
+        case "example":
+            return new Corpus(Collections.singletonList(resource("/example.cpp")));
+        case "min":
+            return new Corpus(Collections.singletonList(resource("/min.cpp")));
+        case "scaled":
+            String example = resource("/example.cpp");
+            List<String> sources = new ArrayList<>(SCALED_FILES);
+            for (int i = 0; i < SCALED_FILES; i++)
+                sources.add("namespace Copy" + i + " {\n" + example + "\n}\n");
+            return new Corpus(sources);
+        case "generated":
+            return generated(CorpusGenerator.parseSize(System.getProperty("corpus.bytes", GENERATED_BYTES)));
+        default:
+            throw new IllegalArgumentException("unknown corpus: " + name);
+        }
+    }
+
+    private static Corpus generated(long bytes) {
+        CorpusGenerator generator = new CorpusGenerator(1);
+        List<String> sources = new ArrayList<>();
+        for (long total = 0; total < bytes;) {
+            String source = generator.generate(sources.size());
+            sources.add(source);
+            total += source.length();
+        }
+        return new Corpus(sources);
+    }
+
+    List<String> getSources() {
+        return sources;
+    }
+
+    /**
+     * Total UTF-8 size of the sources.
+     */
+    long getBytes() {
+        return bytes;
+    }
+
+    private static String resource(String name) throws IOException {
+        try (InputStream is = Corpus.class.getResourceAsStream(name)) {
+            ByteArrayOutputStream out = new ByteArrayOutputStream();
+            byte[] buffer = new byte[8192];
+            for (int n; (n = is.read(buffer)) > 0;)
+                out.write(buffer, 0, n);
+            return new String(out.toByteArray(), StandardCharsets.UTF_8);
+        }
+    }
+}
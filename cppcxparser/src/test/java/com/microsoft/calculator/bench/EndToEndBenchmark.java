@@ -0,0 +1,78 @@
+package com.microsoft.calculator.bench;
+
+import java.io.IOException;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+import com.microsoft.calculator.ApiModel;
+import com.microsoft.calculator.CxListener;
+import com.microsoft.calculator.TwoStageParser;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.tree.ParseTreeWalker;
+import org.openjdk.jmh.annotations.AuxCounters;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * Lexing, parsing and model extraction back to back, the way App processes
+ * a file. Besides corpora per second, JMH reports the {@code bytes} and
+ * {@code files} counters as rates, which give MB/s and files/s.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.Throughput)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class EndToEndBenchmark {
+
+    @Param({ "example", "min", "scaled" })
+    public String corpus;
+
+    private Corpus sources;
+    private final TwoStageParser twoStage = new TwoStageParser();
+
+    @State(Scope.Thread)
+    @AuxCounters(AuxCounters.Type.OPERATIONS)
+    public static class Throughput {
+        public long bytes;
+        public long files;
+
+        @Setup(Level.Iteration)
+        public void reset() {
+            bytes = 0;
+            files = 0;
+        }
+    }
+
+    @Setup
+    public void setUp() throws IOException {
+        sources = Corpus.load(corpus);
+    }
+
+    @Benchmark
+    public ApiModel extract(Throughput throughput) {
+        ApiModel model = new ApiModel();
+        for (String source : sources.getSources()) {
+            CPPCXParser parser = new CPPCXParser(
+                    new CommonTokenStream(new CPPCXLexer(CharStreams.fromString(source))));
+            parser.removeErrorListeners();
+            CxListener listener = new CxListener();
+            ParseTreeWalker.DEFAULT.walk(listener, twoStage.parse(parser));
+            model.merge(listener.getModel());
+        }
+        throughput.bytes += sources.getBytes();
+        throughput.files += sources.getSources().size();
+        return model;
+    }
+}
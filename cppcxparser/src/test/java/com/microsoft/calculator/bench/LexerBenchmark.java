@@ -0,0 +1,53 @@
+package com.microsoft.calculator.bench;
+
+import java.io.IOException;
+import java.util.concurrent.TimeUnit;
+
+import com.microsoft.CPPCXLexer;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * Lexing alone: every token of the corpus, hidden ones included.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class LexerBenchmark {
+
+    @Param({ "example", "min", "scaled" })
+    public String corpus;
+
+    private Corpus sources;
+
+    @Setup
+    public void setUp() throws IOException {
+        sources = Corpus.load(corpus);
+    }
+
+    @Benchmark
+    public int lex() {
+        int tokens = 0;
+        for (String source : sources.getSources()) {
+            CommonTokenStream stream = new CommonTokenStream(new CPPCXLexer(CharStreams.fromString(source)));
+            stream.fill();
+            tokens += stream.size();
+        }
+        return tokens;
+    }
+}
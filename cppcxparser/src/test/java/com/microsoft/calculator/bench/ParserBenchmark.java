@@ -0,0 +1,82 @@
+package com.microsoft.calculator.bench;
+
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.TimeUnit;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+import com.microsoft.calculator.TwoStageParser;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.ListTokenSource;
+import org.antlr.v4.runtime.ParserRuleContext;
+import org.antlr.v4.runtime.Token;
+import org.antlr.v4.runtime.atn.PredictionMode;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * Parsing alone over pre-lexed tokens with SLL, full LL, or
+ * {@link TwoStageParser}.
+ *
+ * The DFA is shared across iterations as in a long-running process, so
+ * after warm-up this measures parsing with a populated DFA. SLL uses the
+ * default error strategy, so it reports rather than recovers from inputs it
+ * cannot handle.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class ParserBenchmark {
+
+    @Param({ "example", "min", "scaled" })
+    public String corpus;
+
+    @Param({ "SLL", "LL", "TWO_STAGE" })
+    public String mode;
+
+    private final List<List<Token>> tokens = new ArrayList<>();
+    private final TwoStageParser twoStage = new TwoStageParser();
+
+    @Setup
+    public void setUp() throws IOException {
+        for (String source : Corpus.load(corpus).getSources()) {
+            CommonTokenStream stream = new CommonTokenStream(new CPPCXLexer(CharStreams.fromString(source)));
+            stream.fill();
+            tokens.add(new ArrayList<>(stream.getTokens()));
+        }
+    }
+
+    @Benchmark
+    public int parse() {
+        int errors = 0;
+        for (List<Token> fileTokens : tokens) {
+            CPPCXParser parser = new CPPCXParser(new CommonTokenStream(new ListTokenSource(fileTokens)));
+            parser.removeErrorListeners();
+            ParserRuleContext tree;
+            if (mode.equals("TWO_STAGE")) {
+                tree = twoStage.parse(parser);
+            } else {
+                parser.getInterpreter().setPredictionMode(mode.equals("SLL") ? PredictionMode.SLL : PredictionMode.LL);
+                tree = parser.translationUnit();
+            }
+            errors += parser.getNumberOfSyntaxErrors() + (tree == null ? 1 : 0);
+        }
+        return errors;
+    }
+}
@@ -0,0 +1,66 @@
+package com.microsoft.calculator.bench;
+
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.TimeUnit;
+
+import com.microsoft.CPPCXLexer;
+import com.microsoft.CPPCXParser;
+import com.microsoft.calculator.CxListener;
+import com.microsoft.calculator.TwoStageParser;
+
+import org.antlr.v4.runtime.CharStreams;
+import org.antlr.v4.runtime.CommonTokenStream;
+import org.antlr.v4.runtime.tree.ParseTree;
+import org.antlr.v4.runtime.tree.ParseTreeWalker;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * Extracting the API model from parse trees built in setup.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class WalkBenchmark {
+
+    @Param({ "example", "min", "scaled" })
+    public String corpus;
+
+    private final List<ParseTree> trees = new ArrayList<>();
+
+    @Setup
+    public void setUp() throws IOException {
+        TwoStageParser twoStage = new TwoStageParser();
+        for (String source : Corpus.load(corpus).getSources()) {
+            CPPCXParser parser = new CPPCXParser(
+                    new CommonTokenStream(new CPPCXLexer(CharStreams.fromString(source))));
+            parser.removeErrorListeners();
+            trees.add(twoStage.parse(parser));
+        }
+    }
+
+    @Benchmark
+    public int walk() {
+        int classes = 0;
+        for (ParseTree tree : trees) {
+            CxListener listener = new CxListener();
+            ParseTreeWalker.DEFAULT.walk(listener, tree);
+            classes += listener.getModel().getClasses().size();
+        }
+        return classes;
+    }
+}